@@ -0,0 +1,306 @@
+/***************************************************************************
+    Headless Benchmark Runner.
+
+    Runs the core without a frontend, for a fixed number of frames, and
+    reports the speed as JSON on stdout. The game is driven by the attract
+    mode AI, or by an input log recorded with the Input Log core option.
+
+    Usage: cannonball_bench <rom directory> [options]
+
+      --frames N       Frames to time (default 3600)
+      --warmup N       Frames to run before timing starts (default 120)
+      --log FILE       Play back an input log, rather than watching attract mode
+      --set KEY=VALUE  Set a core option (e.g. cannonball_video_fps=2)
+      --profile FILE   Write the routine profile of the timed frames, as JSON
+                       if FILE ends in .json, otherwise CSV. Needs a core
+                       built with PROFILE_ROUTINES=1.
+      --verbose        Show the core's log messages
+
+    Deterministic mode is enabled by default, so the state hash reported at
+    the end can be compared between runs.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <libretro.h>
+#include <streams/file_stream.h>
+
+#include "cannonball_api.h"
+#include "timing.hpp"
+
+extern struct retro_core_option_v2_definition option_defs_us[];
+
+static std::map<std::string, std::string> options;
+static std::string save_dir;
+static bool verbose = false;
+static uint32_t frames_drawn = 0;
+
+static void log_printf(enum retro_log_level level, const char *fmt, ...)
+{
+    if (!verbose && level < RETRO_LOG_WARN)
+        return;
+
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+// Overridden options, or the core's defaults
+static const char* get_option(const char* key)
+{
+    std::map<std::string, std::string>::const_iterator it = options.find(key);
+    if (it != options.end())
+        return it->second.c_str();
+
+    for (int i = 0; option_defs_us[i].key != NULL; i++)
+    {
+        if (strcmp(option_defs_us[i].key, key) == 0)
+            return option_defs_us[i].default_value;
+    }
+    return NULL;
+}
+
+static bool environment(unsigned cmd, void *data)
+{
+    switch (cmd)
+    {
+        case RETRO_ENVIRONMENT_GET_VARIABLE:
+        {
+            struct retro_variable* var = (struct retro_variable*) data;
+            var->value = get_option(var->key);
+            return var->value != NULL;
+        }
+
+        case RETRO_ENVIRONMENT_GET_LOG_INTERFACE:
+            ((struct retro_log_callback*) data)->log = log_printf;
+            return true;
+
+        case RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY:
+        case RETRO_ENVIRONMENT_GET_SYSTEM_DIRECTORY:
+            *(const char**) data = save_dir.c_str();
+            return true;
+
+        case RETRO_ENVIRONMENT_GET_CAN_DUPE:
+            *(bool*) data = true;
+            return true;
+
+        case RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE:
+            *(int*) data = 3;
+            return true;
+
+        case RETRO_ENVIRONMENT_SET_PIXEL_FORMAT:
+            return *(enum retro_pixel_format*) data == RETRO_PIXEL_FORMAT_RGB565;
+
+        default:
+            return false;
+    }
+}
+
+static void video_refresh(const void *data, unsigned width, unsigned height, size_t pitch)
+{
+    frames_drawn++;
+}
+
+static void audio_sample(int16_t left, int16_t right) {}
+static size_t audio_sample_batch(const int16_t *data, size_t frames) { return frames; }
+static void input_poll(void) {}
+static int16_t input_state(unsigned port, unsigned device, unsigned index, unsigned id) { return 0; }
+
+// Nearest rank percentile of sorted values
+static double percentile(const std::vector<uint64_t>& sorted, double p)
+{
+    size_t i = (size_t) (p * sorted.size());
+    if (i >= sorted.size())
+        i = sorted.size() - 1;
+    return sorted[i] / 1e6;
+}
+
+// Remove the scratch directory and the files the core wrote to it
+static void remove_scratch()
+{
+    DIR* dir = opendir(save_dir.c_str());
+    if (dir == NULL)
+        return;
+
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL)
+    {
+        if (strcmp(entry->d_name, ".") != 0 && strcmp(entry->d_name, "..") != 0)
+            unlink((save_dir + "/" + entry->d_name).c_str());
+    }
+    closedir(dir);
+    rmdir(save_dir.c_str());
+}
+
+static int usage()
+{
+    fprintf(stderr, "Usage: cannonball_bench <rom directory> [--frames N] [--warmup N] [--log FILE] [--set KEY=VALUE] [--profile FILE] [--verbose]\n");
+    return 1;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+        return usage();
+
+    std::string rom_dir = argv[1];
+    std::string log_file;
+    std::string profile_file;
+    uint32_t frames = 3600;
+    uint32_t warmup = 120;
+
+    // Boot straight into attract mode, with repeatable randomness
+    options["cannonball_menu_enabled"]  = "OFF";
+    options["cannonball_deterministic"] = "ON";
+
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+            frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+            warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+            log_file = argv[++i];
+        else if (strcmp(argv[i], "--set") == 0 && i + 1 < argc)
+        {
+            std::string kv = argv[++i];
+            size_t eq = kv.find('=');
+            if (eq == std::string::npos)
+                return usage();
+            options[kv.substr(0, eq)] = kv.substr(eq + 1);
+        }
+        else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc)
+            profile_file = argv[++i];
+        else if (strcmp(argv[i], "--verbose") == 0)
+            verbose = true;
+        else
+            return usage();
+    }
+
+    if (frames == 0)
+        return usage();
+
+    // Scores and logs are written to a scratch directory, leaving the user's alone
+    char scratch[] = "/tmp/cannonball_bench.XXXXXX";
+    if (mkdtemp(scratch) == NULL)
+    {
+        fprintf(stderr, "Cannot create scratch directory\n");
+        return 1;
+    }
+    save_dir = scratch;
+    atexit(remove_scratch);
+
+    // The core plays back input_log.cbi from the save directory
+    if (!log_file.empty())
+    {
+        void* buf   = NULL;
+        int64_t len = 0;
+        if (!filestream_read_file(log_file.c_str(), &buf, &len))
+        {
+            fprintf(stderr, "Cannot open input log: %s\n", log_file.c_str());
+            return 1;
+        }
+
+        std::string dst = save_dir + "/input_log.cbi";
+        bool written = filestream_write_file(dst.c_str(), buf, len);
+        free(buf);
+        if (!written)
+            return 1;
+
+        options["cannonball_input_log"] = "playback";
+    }
+
+    retro_set_environment(environment);
+    retro_set_video_refresh(video_refresh);
+    retro_set_audio_sample(audio_sample);
+    retro_set_audio_sample_batch(audio_sample_batch);
+    retro_set_input_poll(input_poll);
+    retro_set_input_state(input_state);
+    retro_init();
+
+    // Only the directory of the path is used
+    std::string rom_path = rom_dir + "/";
+    struct retro_game_info info;
+    memset(&info, 0, sizeof(info));
+    info.path = rom_path.c_str();
+
+    if (!retro_load_game(&info))
+    {
+        fprintf(stderr, "Cannot load ROMs from: %s\n", rom_dir.c_str());
+        retro_deinit();
+        return 1;
+    }
+
+    for (uint32_t i = 0; i < warmup; i++)
+        retro_run();
+
+    std::vector<uint64_t> frame_ns;
+    frame_ns.reserve(frames);
+
+    if (!profile_file.empty() && !cannonball_debug_profile_start())
+    {
+        fprintf(stderr, "Routine profiler not available: Build with PROFILE_ROUTINES=1\n");
+        profile_file.clear();
+    }
+
+    timing::reset();
+    timing::enabled = true;
+    frames_drawn = 0;
+
+    const uint64_t start = timing::now();
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        const uint64_t t = timing::now();
+        retro_run();
+        frame_ns.push_back(timing::now() - t);
+    }
+    const uint64_t elapsed = timing::now() - start;
+
+    timing::enabled = false;
+
+    if (!profile_file.empty() && !cannonball_debug_profile_dump(profile_file.c_str()))
+        fprintf(stderr, "Cannot write routine profile: %s\n", profile_file.c_str());
+
+    uint32_t tick = 0;
+    const uint32_t hash = cannonball_debug_state_hash(&tick);
+
+    retro_unload_game();
+    retro_deinit();
+
+    std::sort(frame_ns.begin(), frame_ns.end());
+    uint64_t sum = 0;
+    for (size_t i = 0; i < frame_ns.size(); i++)
+        sum += frame_ns[i];
+
+    const double seconds = elapsed / 1e9;
+
+    printf("{\n");
+    printf("  \"frames\": %u,\n", frames);
+    printf("  \"frames_drawn\": %u,\n", frames_drawn);
+    printf("  \"seconds\": %.6f,\n", seconds);
+    printf("  \"fps\": %.2f,\n", frames / seconds);
+    printf("  \"frame_ms\": { \"mean\": %.4f, \"p50\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+           (sum / 1e6) / frames, percentile(frame_ns, 0.50), percentile(frame_ns, 0.99), frame_ns.back() / 1e6);
+    printf("  \"section_ms_per_frame\": {");
+    for (int i = 0; i < timing::SECTIONS; i++)
+        printf("%s \"%s\": %.4f", i ? "," : "", timing::NAMES[i], (timing::total[i] / 1e6) / frames);
+    printf(" },\n");
+    printf("  \"tick\": %u,\n", tick);
+    printf("  \"state_hash\": \"%08x\"\n", hash);
+    printf("}\n");
+
+    return 0;
+}
@@ -18,6 +18,7 @@ X More cars seem to be high pitched than on MAME. (Fixed - engine channel setup)
 
 #include <cstring> // For memset on GCC
 #include "engine/audio/osound.hpp"
+#include "savestate.hpp"
 
 #ifdef __PS3__
 #define memcpy std::memcpy
@@ -63,6 +64,18 @@ void OSound::init(YM2151* ym, uint8_t* pcm_ram)
     init_fm_chip();
 }
 
+// The whole object is saved, other than its references to the sound chips
+void OSound::sync_state(StateBuf& state)
+{
+    uint8_t* pcm_ram = this->pcm_ram;
+    YM2151*  ym      = this->ym;
+
+    state.sync(*this);
+
+    this->pcm_ram = pcm_ram;
+    this->ym      = ym;
+}
+
 // Initialize FM Chip. Initalize and start Timer A.
 // Source: 0x79
 void OSound::init_fm_chip()
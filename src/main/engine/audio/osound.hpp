@@ -208,6 +208,8 @@ namespace ch_engines
 
 
 
+class StateBuf;
+
 class OSound
 {
 public:
@@ -230,6 +232,7 @@ public:
     void init(YM2151* ym, uint8_t* pcm_ram);
     void init_fm_chip();
     void tick();
+    void sync_state(StateBuf& state);
 
 private:
     const static uint16_t PCM_RAM_SIZE  = 0x100;
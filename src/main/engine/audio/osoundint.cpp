@@ -12,13 +12,17 @@
 #include "engine/outrun.hpp"
 #include "engine/audio/osound.hpp"
 #include "engine/audio/osoundint.hpp"
+#include "savestate.hpp"
+#include "timing.hpp"
+#include "trace.hpp"
 
-OSoundInt osoundint;
-OSound osound;
+ENGINE_GLOBAL OSoundInt osoundint;
+ENGINE_GLOBAL OSound osound;
 
 OSoundInt::OSoundInt()
 {
     pcm_ram = new uint8_t[PCM_RAM_SIZE];
+    program = &osound;
     has_booted = false;
 }
 
@@ -35,8 +39,8 @@ void OSoundInt::init()
     if (ym == NULL)
         ym = new YM2151(0.5f, SOUND_CLOCK);
 
-    pcm->init(config.fps);
-    ym->init(44100, config.fps);
+    pcm->init(config.sound.rate, config.fps);
+    ym->init(config.sound.rate, config.fps);
 
     reset();
 
@@ -47,7 +51,7 @@ void OSoundInt::init()
     for (uint8_t i = 0; i < 8; i++)
         engine_data[i] = 0;
 
-    osound.init(ym, pcm_ram);
+    program->init(ym, pcm_ram);
 }
 
 // Clear sound queue
@@ -60,29 +64,103 @@ void OSoundInt::reset()
     sounds_queued = 0;
 }
 
-void OSoundInt::tick()
+// Save or restore the sound program and the state of both sound chips.
+// The chips are created when the core is initialised, before any state is requested.
+void OSoundInt::sync_state(StateBuf& state)
+{
+    state.sync(has_booted);
+    state.sync(engine_data);
+    state.sync(sound_counter);
+    state.sync(queue);
+    state.sync(sounds_queued);
+    state.sync(sound_head);
+    state.sync(sound_tail);
+    state.sync(pcm_ram, PCM_RAM_SIZE);
+
+    program->sync_state(state);
+
+    if (pcm != NULL)
+        pcm->sync_state(state);
+    if (ym != NULL)
+        ym->sync_state(state);
+}
+
+// Run the sound program code for a frame, rendering the given number of samples 
+// from the sound chips alongside it. Pass 0 to run the program code only.
+void OSoundInt::tick(uint32_t samples)
+{
+    frame_t f;
+    latch_frame(&f);
+    run_frame(&f, samples);
+}
+
+// Run the 68000 side of the sound interface for one frame.
+// The Z80 services its interrupt at 120Hz, so the number of interrupts per frame varies with the framerate.
+void OSoundInt::latch_frame(frame_t* f)
 {
     if (config.fps == 30)
     {
-        play_queued_sound(); // Process audio commands from main program code
-        osound.tick();
-        play_queued_sound();
-        osound.tick();
-        play_queued_sound();
-        osound.tick();
-        play_queued_sound();
-        osound.tick();
+        f->z80_ticks = 4;
+        for (uint8_t i = 0; i < 4; i++)
+            play_queued_sound(f, i); // Process audio commands from main program code
     }
     else if (config.fps == 60)
     {
-        play_queued_sound(); // Process audio commands from main program code
-        osound.tick();
-        osound.tick();
+        f->z80_ticks = 2;
+        play_queued_sound(f, 0);     // Process audio commands from main program code
+        f->latched[1] = false;
+    }
+    else
+    {
+        f->z80_ticks = 1;
+        play_queued_sound(f, 0);     // Process audio commands from main program code
+    }
+}
+
+// Run the Z80 program code for one frame, passing in the latched commands before each interrupt.
+//
+// Each interrupt is timestamped with the sample it falls on. The sound chips are rendered up to
+// that sample before the interrupt runs, so register writes made by the Z80 take effect from there, 
+// and values fed back by the chips (PCM addresses, timer status) are current when the Z80 reads them.
+void OSoundInt::run_frame(const frame_t* f, uint32_t samples)
+{
+    trace::Scope phase("osoundint.run_frame");
+
+    for (uint8_t i = 0; i < f->z80_ticks; i++)
+    {
+        if (samples)
+        {
+            const uint32_t timestamp = (samples * i) / f->z80_ticks;
+            {
+                timing::Scope t(timing::PCM);
+                pcm->stream_to(timestamp);
+            }
+            {
+                timing::Scope t(timing::FM);
+                ym->stream_to(timestamp);
+            }
+        }
+
+        if (f->latched[i])
+        {
+            program->command_input = f->command[i];
+            for (uint8_t j = 1; j < 8; j++)
+                program->engine_data[j] = f->engine_data[i][j];
+        }
+        program->tick();
     }
-    else if (config.fps == 120)
+
+    // Render remainder of frame
+    if (samples)
     {
-        play_queued_sound(); // Process audio commands from main program code
-        osound.tick();
+        {
+            timing::Scope t(timing::PCM);
+            pcm->stream_update(samples);
+        }
+        {
+            timing::Scope t(timing::FM);
+            ym->stream_update(samples);
+        }
     }
 }
 
@@ -93,8 +171,10 @@ void OSoundInt::tick()
 // Play Queued Sounds & Send Engine Noise Commands to Z80
 // Was called by horizontal interrupt routine
 // Source: 0x564E
-void OSoundInt::play_queued_sound()
+void OSoundInt::play_queued_sound(frame_t* f, uint8_t z80_tick)
 {
+    f->latched[z80_tick] = has_booted;
+
     if (!has_booted)
     {
         sound_head = 0;
@@ -110,19 +190,19 @@ void OSoundInt::play_queued_sound()
         {
             if (sounds_queued != 0)
             {
-                osound.command_input = queue[sound_head];
+                f->command[z80_tick] = queue[sound_head];
                 sound_head = (sound_head + 1) & QUEUE_LENGTH;
                 sounds_queued--;
             }
             else
             {
-                osound.command_input = sound::RESET;
+                f->command[z80_tick] = sound::RESET;
             }
         }
         // Process player engine sounds and passing traffic
         else
         {
-            osound.engine_data[counter] = engine_data[counter];
+            f->engine_data[z80_tick][counter] = engine_data[counter];
         }
     }
 }
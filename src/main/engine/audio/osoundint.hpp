@@ -15,6 +15,9 @@
 #include "hwaudio/ym2151.hpp"
 #include "engine/audio/commands.hpp"
 
+class StateBuf;
+class OSound;
+
 class OSoundInt
 {
 public:
@@ -39,17 +42,34 @@ public:
     // [+7] Traffic data #4
     uint8_t engine_data[8];
 
+    // Maximum Z80 interrupts serviced per frame (at 30fps)
+    static const uint8_t MAX_Z80_TICKS = 4;
+
+    // Commands latched from the 68000 side for each Z80 interrupt of a frame.
+    // Allows the Z80 program and sound chips to be run away from the main
+    // program code, as this is the only data passed between the two.
+    struct frame_t
+    {
+        uint8_t z80_ticks;
+        bool    latched[MAX_Z80_TICKS];
+        uint8_t command[MAX_Z80_TICKS];
+        uint8_t engine_data[MAX_Z80_TICKS][8];
+    };
+
     OSoundInt();
     ~OSoundInt();
 
     void init();
     void reset();
-    void tick();
+    void tick(uint32_t samples);
+    void latch_frame(frame_t* f);
+    void run_frame(const frame_t* f, uint32_t samples);
 
-    void play_queued_sound();
+    void play_queued_sound(frame_t* f, uint8_t z80_tick);
     void queue_sound_service(uint8_t snd);
     void queue_sound(uint8_t snd);
     void queue_clear();
+    void sync_state(StateBuf& state);
 
 private:
     // 4 MHz
@@ -58,6 +78,9 @@ private:
     // Reference to 0xFF bytes of PCM Chip RAM
     uint8_t* pcm_ram;
 
+    // Z80 sound program. Held here, so the synthesis thread runs the program belonging to this interface.
+    OSound* program;
+
     // Controls what type of sound we're going to process in the interrupt routine
     uint8_t sound_counter;
 
@@ -73,4 +96,4 @@ private:
     void add_to_queue(uint8_t snd);
 };
 
-extern OSoundInt osoundint;
\ No newline at end of file
+extern ENGINE_GLOBAL OSoundInt osoundint;
\ No newline at end of file
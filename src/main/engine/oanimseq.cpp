@@ -37,7 +37,7 @@
 //                     (Before Incrementing To Next Block Of 8 Bytes)
 // ----------------------------------------------------------------------------
 
-OAnimSeq oanimseq;
+ENGINE_GLOBAL OAnimSeq oanimseq;
 
 OAnimSeq::OAnimSeq(void)
 {
@@ -129,8 +129,8 @@ void OAnimSeq::flag_seq()
             // Index of animation sequences
             uint32_t index = outrun.adr.anim_seq_flag + ((outrun.game_state - 9) << 3);
 
-            anim_flag.anim_addr_curr = roms.rom0p->read32(&index);
-            anim_flag.anim_addr_next = roms.rom0p->read32(&index);
+            anim_flag.anim_addr_curr = roms.rom0p->read32n(&index);
+            anim_flag.anim_addr_next = roms.rom0p->read32n(&index);
 
             anim_flag.frame_delay = roms.rom0p->read8(7 + anim_flag.anim_addr_curr) & 0x3F;
             anim_flag.anim_frame  = 0;
@@ -141,11 +141,11 @@ void OAnimSeq::flag_seq()
         {
             uint32_t index = anim_flag.anim_addr_curr + (anim_flag.anim_frame << 3);
 
-            anim_flag.sprite->addr    = roms.rom0p->read32(index) & 0xFFFFF;
+            anim_flag.sprite->addr    = roms.rom0p->read32n(index) & 0xFFFFF;
             anim_flag.sprite->pal_src = roms.rom0p->read8(index);
 
 	        uint32_t addr = SPRITE_ZOOM_LOOKUP + (((anim_flag.sprite->z >> 16) << 2) | osprites.sprite_scroll_speed);
-	        uint32_t value = roms.rom0p->read32(addr);
+	        uint32_t value = roms.rom0p->read32n(addr);
 	        anim_flag.sprite->z += value;
             uint16_t z16 = anim_flag.sprite->z >> 16;
 	    
@@ -250,11 +250,11 @@ void OAnimSeq::anim_seq_intro(oanimsprite* anim)
 
         uint32_t index              = anim->anim_addr_curr + (anim->anim_frame << 3);
 
-        anim->sprite->addr          = roms.rom0p->read32(index) & 0xFFFFF;
+        anim->sprite->addr          = roms.rom0p->read32n(index) & 0xFFFFF;
         anim->sprite->pal_src       = roms.rom0p->read8(index);
         anim->sprite->zoom          = 0x7F;
         anim->sprite->road_priority = 0x1FE;
-        anim->sprite->priority      = 0x1FE - ((roms.rom0p->read16(index) & 0x70) >> 4);
+        anim->sprite->priority      = 0x1FE - ((roms.rom0p->read16n(index) & 0x70) >> 4);
 
         // Set X
         int16_t sprite_x = (int8_t) roms.rom0p->read8(4 + index);
@@ -372,8 +372,8 @@ void OAnimSeq::init_end_sprites()
 {
     // Ferrari Object [0x5B12 entry point]
     uint32_t addr = outrun.adr.anim_endseq_obj1 + (end_seq << 3);
-    anim_ferrari.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_ferrari.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_ferrari.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_ferrari.anim_addr_next = roms.rom0p->read32n(&addr);
     ferrari_stopped = false;
     
     // 0x58A4: Car Door Opening Animation [seq_sprite_entry]
@@ -385,8 +385,8 @@ void OAnimSeq::init_end_sprites()
     anim_obj1.frame_delay = 0;
     anim_obj1.anim_props = 0;
     addr = outrun.adr.anim_endseq_obj2 + (end_seq << 3);
-    anim_obj1.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_obj1.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_obj1.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_obj1.anim_addr_next = roms.rom0p->read32n(&addr);
     
     // 0x58EC: Interior of Ferrari (Note this wobbles a little when passengers exit) [seq_sprite_entry]
     anim_obj2.sprite->control |= OSprites::ENABLE;
@@ -396,8 +396,8 @@ void OAnimSeq::init_end_sprites()
     anim_obj2.frame_delay = 0;
     anim_obj2.anim_props = 0;
     addr = outrun.adr.anim_endseq_obj3 + (end_seq << 3);
-    anim_obj2.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_obj2.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_obj2.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_obj2.anim_addr_next = roms.rom0p->read32n(&addr);
 
     // 0x592A: Car Shadow [SeqSpriteShadow]
     anim_obj3.sprite->control |= OSprites::ENABLE;
@@ -416,8 +416,8 @@ void OAnimSeq::init_end_sprites()
     anim_pass1.frame_delay = 0;
     anim_pass1.anim_props = 0;
     addr = outrun.adr.anim_endseq_obj4 + (end_seq << 3);
-    anim_pass1.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_pass1.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_pass1.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_pass1.anim_addr_next = roms.rom0p->read32n(&addr);
 
     // 0x5998: Man Shadow [SeqSpriteShadow]
     anim_obj4.sprite->control = OSprites::ENABLE;
@@ -437,8 +437,8 @@ void OAnimSeq::init_end_sprites()
     anim_pass2.frame_delay = 0;
     anim_pass2.anim_props = 0;
     addr = outrun.adr.anim_endseq_obj5 + (end_seq << 3);
-    anim_pass2.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_pass2.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_pass2.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_pass2.anim_addr_next = roms.rom0p->read32n(&addr);
 
     // 0x59F6: Female Shadow [SeqSpriteShadow]
     anim_obj5.sprite->control = OSprites::ENABLE;
@@ -458,8 +458,8 @@ void OAnimSeq::init_end_sprites()
     anim_obj6.frame_delay = 0;
     anim_obj6.anim_props = 0;
     addr = outrun.adr.anim_endseq_obj6 + (end_seq << 3);
-    anim_obj6.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_obj6.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_obj6.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_obj6.anim_addr_next = roms.rom0p->read32n(&addr);
 
     // Alternate Use Based On End Sequence
     anim_obj7.sprite->control |= OSprites::ENABLE;
@@ -473,8 +473,8 @@ void OAnimSeq::init_end_sprites()
     if (end_seq == 4)
     {
         addr = outrun.adr.anim_endseq_objB + (end_seq << 3);
-        anim_obj7.anim_addr_curr = roms.rom0p->read32(&addr);
-        anim_obj7.anim_addr_next = roms.rom0p->read32(&addr);
+        anim_obj7.anim_addr_curr = roms.rom0p->read32n(&addr);
+        anim_obj7.anim_addr_next = roms.rom0p->read32n(&addr);
     }
     // Trophy Shadow
     else
@@ -491,8 +491,8 @@ void OAnimSeq::init_end_sprites()
     anim_obj8.frame_delay = 0;
     anim_obj8.anim_props = 0xFF00;
     addr = outrun.adr.anim_endseq_obj7 + (end_seq << 3);
-    anim_obj8.anim_addr_curr = roms.rom0p->read32(&addr);
-    anim_obj8.anim_addr_next = roms.rom0p->read32(&addr);
+    anim_obj8.anim_addr_curr = roms.rom0p->read32n(&addr);
+    anim_obj8.anim_addr_next = roms.rom0p->read32n(&addr);
     
     end_seq_state = 1;
 }
@@ -533,11 +533,11 @@ void OAnimSeq::anim_seq_outro(oanimsprite* anim)
         // Process Animation Data
         uint32_t index = anim->anim_addr_curr + (anim->anim_frame << 3);
 
-        anim->sprite->addr          = roms.rom0p->read32(index) & 0xFFFFF;
+        anim->sprite->addr          = roms.rom0p->read32n(index) & 0xFFFFF;
         anim->sprite->pal_src       = roms.rom0p->read8(index);
         anim->sprite->zoom          = roms.rom0p->read8(6 + index) >> 1;
         anim->sprite->road_priority = roms.rom0p->read8(6 + index) << 1;
-        anim->sprite->priority      = anim->sprite->road_priority - ((roms.rom0p->read16(index) & 0x70) >> 4); // (bits 4-6)
+        anim->sprite->priority      = anim->sprite->road_priority - ((roms.rom0p->read16n(index) & 0x70) >> 4); // (bits 4-6)
         anim->sprite->x             = (roms.rom0p->read8(4 + index) * anim->sprite->priority) >> 9;
     
         if (roms.rom0p->read8(1 + index) & BIT_7)
@@ -623,8 +623,8 @@ bool OAnimSeq::read_anim_data(oanimsprite* anim)
     uint32_t addr = outrun.adr.anim_end_table + (end_seq << 2) + (anim->sprite->id << 2) +  (anim->sprite->id << 4); // a0 + d1
 
     // Read start & end position in animation timeline for this object
-    int16_t start_pos = roms.rom0p->read16(addr);     // d0
-    int16_t end_pos =   roms.rom0p->read16(2 + addr); // d3
+    int16_t start_pos = roms.rom0p->read16n(addr);     // d0
+    int16_t end_pos =   roms.rom0p->read16n(2 + addr); // d3
 
     int16_t pos = seq_pos; // d1
     
@@ -686,8 +686,8 @@ bool OAnimSeq::read_anim_data(oanimsprite* anim)
             if (end_seq >= 2)
                 anim->sprite->shadow = 7;
 
-            anim->anim_addr_curr = roms.rom0p->read32(outrun.adr.anim_endseq_obj8 + (end_seq << 3));
-            anim->anim_addr_next = roms.rom0p->read32(outrun.adr.anim_endseq_obj8 + (end_seq << 3) + 4);
+            anim->anim_addr_curr = roms.rom0p->read32n(outrun.adr.anim_endseq_obj8 + (end_seq << 3));
+            anim->anim_addr_next = roms.rom0p->read32n(outrun.adr.anim_endseq_obj8 + (end_seq << 3) + 4);
             anim->anim_frame = 0;
             return DO_NOTHING;
         }
@@ -698,8 +698,8 @@ bool OAnimSeq::read_anim_data(oanimsprite* anim)
             if (end_seq >= 2)
                 anim->sprite->shadow = 7;
 
-            anim->anim_addr_curr = roms.rom0p->read32(outrun.adr.anim_endseq_objA + (end_seq << 3));
-            anim->anim_addr_next = roms.rom0p->read32(outrun.adr.anim_endseq_objA + (end_seq << 3) + 4);
+            anim->anim_addr_curr = roms.rom0p->read32n(outrun.adr.anim_endseq_objA + (end_seq << 3));
+            anim->anim_addr_next = roms.rom0p->read32n(outrun.adr.anim_endseq_objA + (end_seq << 3) + 4);
             anim->anim_frame = 0;
             return DO_NOTHING;
         }
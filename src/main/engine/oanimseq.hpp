@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include "globals.hpp"
 #include "oanimsprite.hpp"
 
 class OAnimSeq
@@ -72,4 +73,4 @@ private:
     bool read_anim_data(oanimsprite*);
 };
 
-extern OAnimSeq oanimseq;
+extern ENGINE_GLOBAL OAnimSeq oanimseq;
@@ -44,16 +44,13 @@
 #include "engine/oinputs.hpp"
 #include "engine/ostats.hpp"
 #include "engine/otraffic.hpp"
+#include "engine/outils.hpp"
 
-#ifdef __PS3__
-#define srand std::srand
-#endif
-
-OAttractAI oattractai;
+ENGINE_GLOBAL OAttractAI oattractai;
 
 OAttractAI::OAttractAI(void)
 {
-    srand((unsigned int) time(NULL));
+    outils::set_entropy((uint32_t) time(NULL)); // Replaced by a fixed seed in deterministic mode
 }
 
 
@@ -79,7 +76,7 @@ void OAttractAI::tick_ai_enhanced()
     if (last_stage != ostats.cur_stage)
     {     
         last_stage           = ostats.cur_stage;
-        oferrari.sprite_ai_x = std::rand() & 1;     
+        oferrari.sprite_ai_x = outils::entropy() & 1;     
     }
 
     // --------------------------------------------------------------------------------------------
@@ -12,7 +12,7 @@
 #include "engine/outils.hpp"
 #include "engine/obonus.hpp"
 
-OBonus obonus;
+ENGINE_GLOBAL OBonus obonus;
 
 OBonus::OBonus(void)
 {
@@ -192,4 +192,4 @@ private:
     void pass_turnhead(oentry*);
 };
 
-extern OCrash ocrash;
\ No newline at end of file
+extern ENGINE_GLOBAL OCrash ocrash;
\ No newline at end of file
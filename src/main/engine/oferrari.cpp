@@ -28,8 +28,9 @@
 #include "engine/ostats.hpp"
 #include "engine/outils.hpp"
 #include "engine/oferrari.hpp"
+#include "profiler.hpp"
 
-OFerrari oferrari;
+ENGINE_GLOBAL OFerrari oferrari;
 
 OFerrari::OFerrari(void)
 {
@@ -217,6 +218,7 @@ void OFerrari::init_ingame()
 // Source: 9C84
 void OFerrari::logic()
 {
+    PROFILE_ROUTINE(0x9C84);
     switch (obonus.bonus_control)
     {
         // Not Bonus Mode
@@ -348,6 +350,7 @@ void OFerrari::ferrari_normal()
 // Source: 0x9D30
 void OFerrari::setup_ferrari_sprite()
 {
+    PROFILE_ROUTINE(0x9D30);
     spr_ferrari->y = 221; // Set Default Ferrari Y
     
     // Test Collision With Other Sprite Object
@@ -413,9 +416,9 @@ void OFerrari::setup_ferrari_sprite()
 
         // Set Ferrari Sprite Properties
         uint32_t offset = outrun.adr.sprite_ferrari_frames + turn_frame_offset + incline_frame_offset;
-        spr_ferrari->addr = roms.rom0p->read32(offset);     // Set Ferrari Frame Address
-        sprite_pass_y = roms.rom0p->read16(offset + 4); // Set Passenger Y Offset
-        x_off = roms.rom0p->read16(offset + 6); // Set Ferrari Sprite X Offset
+        spr_ferrari->addr = roms.rom0p->read32n(offset);     // Set Ferrari Frame Address
+        sprite_pass_y = roms.rom0p->read16n(offset + 4); // Set Passenger Y Offset
+        x_off = roms.rom0p->read16n(offset + 6); // Set Ferrari Sprite X Offset
 
         if (d4 < 0) x_off = -x_off;
     }
@@ -448,9 +451,9 @@ void OFerrari::setup_ferrari_sprite()
         if (y >= 0x13) incline_frame_offset += 0x20;
 
         uint32_t offset = outrun.adr.sprite_skid_frames + frame + incline_frame_offset;
-        spr_ferrari->addr = roms.rom0p->read32(offset); // Set Ferrari Frame Address
-        sprite_pass_y = roms.rom0p->read16(offset + 4); // Set Passenger Y Offset
-        x_off = roms.rom0p->read16(offset + 6);         // Set Ferrari Sprite X Offset
+        spr_ferrari->addr = roms.rom0p->read32n(offset); // Set Ferrari Frame Address
+        sprite_pass_y = roms.rom0p->read16n(offset + 4); // Set Passenger Y Offset
+        x_off = roms.rom0p->read16n(offset + 6);         // Set Ferrari Sprite X Offset
         wheel_traction = TRACTION_OFF;                  // Both wheels have lost traction
 
         if (ocrash.skid_counter >= 0) x_off = -x_off;
@@ -487,9 +490,9 @@ void OFerrari::setup_ferrari_bonus_sprite()
 
     // Set Ferrari Sprite Properties
     uint32_t offset   = outrun.adr.sprite_ferrari_frames + turn_frame_offset + 8; // 8 denotes the 'level' frames, no slope.
-    spr_ferrari->addr = roms.rom0p->read32(offset);     // Set Ferrari Frame Address
-    sprite_pass_y     = roms.rom0p->read16(offset + 4); // Set Passenger Y Offset
-    int16_t x_off     = roms.rom0p->read16(offset + 6); // Set Ferrari Sprite X Offset
+    spr_ferrari->addr = roms.rom0p->read32n(offset);     // Set Ferrari Frame Address
+    sprite_pass_y     = roms.rom0p->read16n(offset + 4); // Set Passenger Y Offset
+    int16_t x_off     = roms.rom0p->read16n(offset + 6); // Set Ferrari Sprite X Offset
 
     if (oinputs.steering_adjust < 0) x_off = -x_off;
     spr_ferrari->x = x_off;
@@ -529,7 +532,7 @@ void OFerrari::do_end_seq()
 
     uint32_t addr = outrun.adr.anim_ferrari_frames + ((obonus.bonus_control - 0xC) << 1);
 
-    spr_ferrari->addr    = roms.rom0p->read32(addr);
+    spr_ferrari->addr    = roms.rom0p->read32n(addr);
     sprite_pass_y        = roms.rom0p->read8(4 + addr);  // Set Passenger Y Offset
     spr_ferrari->x       = roms.rom0p->read8(5 + addr);
     spr_ferrari->pal_src = roms.rom0p->read8(6 + addr);
@@ -897,8 +900,8 @@ void OFerrari::set_passenger_sprite(oentry* sprite)
 
     sprite->pal_src = pal;
     uint32_t offset_table = ((sprite == spr_pass1) ? PASS1_OFFSET : PASS2_OFFSET) + frame;
-    sprite->x = spr_ferrari->x + roms.rom0.read16(&offset_table);
-    sprite->y = spr_ferrari->y + roms.rom0.read16(offset_table);
+    sprite->x = spr_ferrari->x + roms.rom0.read16n(&offset_table);
+    sprite->y = spr_ferrari->y + roms.rom0.read16n(offset_table);
     
     sprite->zoom = 0x7F;
     sprite->draw_props = 8;
@@ -960,7 +963,7 @@ void OFerrari::set_passenger_frame(oentry* sprite)
         }
     }
     else
-        sprite->addr = roms.rom0p->read32(addr + inc);
+        sprite->addr = roms.rom0p->read32n(addr + inc);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -972,6 +975,7 @@ void OFerrari::set_passenger_frame(oentry* sprite)
 // Source: 0x6288
 void OFerrari::move()
 {
+    PROFILE_ROUTINE(0x6288);
     if (car_ctrl_active)
     {      
         // Auto braking if necessary
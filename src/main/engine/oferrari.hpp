@@ -300,4 +300,4 @@ private:
     inline void draw_sprite(oentry*);
 };
 
-extern OFerrari oferrari;
\ No newline at end of file
+extern ENGINE_GLOBAL OFerrari oferrari;
\ No newline at end of file
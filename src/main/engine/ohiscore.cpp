@@ -18,7 +18,7 @@
 #include "engine/outils.hpp"
 #include "engine/ohiscore.hpp"
 
-OHiScore ohiscore;
+ENGINE_GLOBAL OHiScore ohiscore;
 
 OHiScore::OHiScore(void)
 {
@@ -56,7 +56,7 @@ void OHiScore::setup_pal_best()
     uint32_t dst = 0x120F00;
 
     for (int i = 0; i <= 0x1F; i++)
-        video.write_pal32(&dst, roms.rom0.read32(&src));
+        video.write_pal32(&dst, roms.rom0.read32n(&src));
 }
 
 // Setup road colour for Best Outrunners High Score Entry
@@ -79,19 +79,19 @@ void OHiScore::init_def_scores()
     for (int i = 0; i < NO_SCORES; i++)
     {
         // Read default score
-        scores[i].score = roms.rom0.read32(&adr);
+        scores[i].score = roms.rom0.read32n(&adr);
 
         // Read initials
-        uint32_t initials = roms.rom0.read32(&adr);
+        uint32_t initials = roms.rom0.read32n(&adr);
         scores[i].initial1 = (initials >> 24) & 0xFF;
         scores[i].initial2 = (initials >> 16) & 0xFF;
         scores[i].initial3 = (initials >> 8) & 0xFF;
 
         // Read default time
-        scores[i].time = roms.rom0.read16(&adr);
+        scores[i].time = roms.rom0.read16n(&adr);
         //scores[i].time = (i & 1) ? 0x4321 : 0x1234; // hack to display 4m 43 51 or 1m 16 56
         // Read map tiles
-        scores[i].maptiles = roms.rom0.read32(&adr);
+        scores[i].maptiles = roms.rom0.read32n(&adr);
         //scores[i].maptiles = 0xe5c8c2d1; // hack to populate map tiles for testing
     }
 }
@@ -201,7 +201,7 @@ void OHiScore::insert_score()
     }
 
     // Setup Appropriate Minimap Tiles
-    scores[score_pos].maptiles = roms.rom0.read32(ohud.setup_mini_map());
+    scores[score_pos].maptiles = roms.rom0.read32n(ohud.setup_mini_map());
 }
 
 // Set Table Position To Display Score From. Store Result in $26
@@ -524,18 +524,18 @@ void OHiScore::tick_minicars()
             // Two versions of routine, one that only blits the car in two tiles
             if ((minicar->pos >> 8) & BIT_0)
             {
-                video.write_text32(&textram_adr, roms.rom0.read32(tiles_adr)); // blit car in 2 tiles
-                video.write_text32(&textram_adr, roms.rom0.read32(&tiles_smoke_adr)); // smoke trail tile 1
-                video.write_text16(&textram_adr, roms.rom0.read16(&tiles_smoke_adr)); // smoke trail tile 2
+                video.write_text32(&textram_adr, roms.rom0.read32n(tiles_adr)); // blit car in 2 tiles
+                video.write_text32(&textram_adr, roms.rom0.read32n(&tiles_smoke_adr)); // smoke trail tile 1
+                video.write_text16(&textram_adr, roms.rom0.read16n(&tiles_smoke_adr)); // smoke trail tile 2
             }
             // Blit at an offset
             // The second blits the mini-car at an offset halfway into the tile (and hence takes 3 tiles)
             else
             {
-                video.write_text32(&textram_adr, roms.rom0.read32(4 + tiles_adr)); // blit car in 3 tiles
-                video.write_text16(&textram_adr, roms.rom0.read16(8 + tiles_adr)); // blit car in 3 tiles
-                video.write_text32(&textram_adr, roms.rom0.read32(&tiles_smoke_adr)); // smoke trail tile 1
-                video.write_text16(&textram_adr, roms.rom0.read16(&tiles_smoke_adr)); // smoke trail tile 2
+                video.write_text32(&textram_adr, roms.rom0.read32n(4 + tiles_adr)); // blit car in 3 tiles
+                video.write_text16(&textram_adr, roms.rom0.read16n(8 + tiles_adr)); // blit car in 3 tiles
+                video.write_text32(&textram_adr, roms.rom0.read32n(&tiles_smoke_adr)); // smoke trail tile 1
+                video.write_text16(&textram_adr, roms.rom0.read16n(&tiles_smoke_adr)); // smoke trail tile 2
             }
 
             // Erase Minicar tiles (0xCFB2)
@@ -130,4 +130,4 @@ private:
     void convert_lap_time(uint16_t);
 };
 
-extern OHiScore ohiscore;
+extern ENGINE_GLOBAL OHiScore ohiscore;
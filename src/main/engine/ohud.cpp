@@ -19,8 +19,9 @@
 #include "engine/ohud.hpp"
 #include "engine/ooutputs.hpp"
 #include "engine/ostats.hpp"
+#include "profiler.hpp"
 
-OHud ohud;
+ENGINE_GLOBAL OHud ohud;
 
 OHud::OHud(void)
 {
@@ -36,6 +37,7 @@ OHud::~OHud(void)
 // Source: 0xB462
 void OHud::draw_main_hud()
 {
+    PROFILE_ROUTINE(0xB462);
     blit_text1(HUD_LAP1);
     blit_text1(HUD_LAP2);
 
@@ -555,9 +557,9 @@ void OHud::draw_credits()
 
 void OHud::blit_text1(uint32_t src_addr)
 {
-    uint32_t dst_addr = roms.rom0.read32(&src_addr); // Text RAM destination address
-    uint16_t counter = roms.rom0.read16(&src_addr);  // Number of tiles to blit
-    uint16_t data = roms.rom0.read16(&src_addr);     // Tile data to blit
+    uint32_t dst_addr = roms.rom0.read32n(&src_addr); // Text RAM destination address
+    uint16_t counter = roms.rom0.read16n(&src_addr);  // Number of tiles to blit
+    uint16_t data = roms.rom0.read16n(&src_addr);     // Tile data to blit
     
     // Blit each tile
     for (uint16_t i = 0; i <= counter; i++)
@@ -571,8 +573,8 @@ void OHud::blit_text1(uint8_t x, uint8_t y, uint32_t src_addr)
 {
     uint32_t dst_addr = translate(x, y);
     src_addr += 4;
-    uint16_t counter = roms.rom0.read16(&src_addr);  // Number of tiles to blit
-    uint16_t data = roms.rom0.read16(&src_addr);     // Tile data to blit
+    uint16_t counter = roms.rom0.read16n(&src_addr);  // Number of tiles to blit
+    uint16_t data = roms.rom0.read16n(&src_addr);     // Tile data to blit
 
     // Blit each tile
     for (uint16_t i = 0; i <= counter; i++)
@@ -599,7 +601,7 @@ void OHud::blit_text1(uint8_t x, uint8_t y, uint32_t src_addr)
 
 void OHud::blit_text2(uint32_t src_addr)
 {
-    uint32_t dst_addr = 0x110000 + roms.rom0.read16(&src_addr); // Text RAM destination address
+    uint32_t dst_addr = 0x110000 + roms.rom0.read16n(&src_addr); // Text RAM destination address
 
     uint16_t pal = roms.rom0.read8(&src_addr); 
     pal = 0x80A0 | ((pal << 9) | (pal >> 7) & 1);
@@ -63,4 +63,4 @@ private:
     void draw_mini_map(uint32_t);
 };
 
-extern OHud ohud;
\ No newline at end of file
+extern ENGINE_GLOBAL OHud ohud;
\ No newline at end of file
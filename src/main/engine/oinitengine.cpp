@@ -29,8 +29,9 @@
 #include "engine/otiles.hpp"
 #include "engine/otraffic.hpp"
 #include "engine/oinitengine.hpp"
+#include "profiler.hpp"
 
-OInitEngine oinitengine;
+ENGINE_GLOBAL OInitEngine oinitengine;
 
 // Continuous Mode Level Ordering
 const static uint8_t CONTINUOUS_LEVELS[] = {0, 0x8, 0x9, 0x10, 0x11, 0x12, 0x18, 0x19, 0x1A, 0x1B, 0x20, 0x21, 0x22, 0x23, 0x24};
@@ -149,6 +150,7 @@ void OInitEngine::init_road_seg_master()
 
 void OInitEngine::update_road()
 {
+    PROFILE_ROUTINE(0xB85A);
     check_road_split(); // Check/Process road split if necessary
     uint32_t addr = 0;
     uint16_t d0 = trackloader.read_width_height(&addr);
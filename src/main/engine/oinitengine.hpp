@@ -170,4 +170,4 @@ private:
     void test_bonus_mode(bool);
 };
 
-extern OInitEngine oinitengine;
\ No newline at end of file
+extern ENGINE_GLOBAL OInitEngine oinitengine;
\ No newline at end of file
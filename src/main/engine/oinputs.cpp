@@ -13,8 +13,10 @@
 #include "engine/ostats.hpp"
 
 #include "cannonboard/interface.hpp"
+#include "inputlog.hpp"
+#include "trace.hpp"
 
-OInputs oinputs;
+ENGINE_GLOBAL OInputs oinputs;
 
 OInputs::OInputs(void)
 {
@@ -50,6 +52,11 @@ void OInputs::init()
 
 void OInputs::tick(Packet* packet)
 {
+    trace::Scope phase("oinputs.tick");
+
+    // Record controls, or replace them during playback
+    inputlog.tick();
+
     // CannonBoard Input
     if (packet != NULL)
     {
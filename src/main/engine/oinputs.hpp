@@ -96,4 +96,4 @@ private:
     void digital_pedals();
 };
 
-extern OInputs oinputs;
+extern ENGINE_GLOBAL OInputs oinputs;
@@ -18,8 +18,9 @@
 #include "engine/outils.hpp"
 #include "engine/olevelobjs.hpp"
 #include "engine/ostats.hpp"
+#include "profiler.hpp"
 
-OLevelObjs olevelobjs;
+ENGINE_GLOBAL OLevelObjs olevelobjs;
 
 OLevelObjs::OLevelObjs(void)
 {
@@ -66,13 +67,14 @@ void OLevelObjs::init_entries(uint32_t a4, const uint8_t start_index, const uint
         sprite->draw_props = roms.rom0p->read8(&a4);
         sprite->shadow     = roms.rom0p->read8(&a4);
         sprite->pal_src    = roms.rom0p->read8(&a4);
-        sprite->type       = roms.rom0p->read16(&a4);
-        sprite->addr       = roms.rom0p->read32(outrun.adr.sprite_type_table + sprite->type);
+        sprite->type       = roms.rom0p->read16n(&a4);
+        osprites.set_active(sprite);
+        sprite->addr       = roms.rom0p->read32n(outrun.adr.sprite_type_table + sprite->type);
         sprite->xw1        = 
-        sprite->xw2        = roms.rom0p->read16(&a4);
-        sprite->yw         = roms.rom0p->read16(&a4);
+        sprite->xw2        = roms.rom0p->read16n(&a4);
+        sprite->yw         = roms.rom0p->read16n(&a4);
 
-        uint16_t z_orig    = roms.rom0p->read16(&a4);
+        uint16_t z_orig    = roms.rom0p->read16n(&a4);
 
         uint32_t z = z_orig;
         outils::swap32(z);
@@ -123,6 +125,7 @@ void OLevelObjs::init_entries(uint32_t a4, const uint8_t start_index, const uint
 // Input: Default Zoom Value
 void OLevelObjs::setup_sprites(uint32_t z)
 {
+    PROFILE_ROUTINE(0x3CB2);
     // Setup entries that have not yet been enabled
     for (uint8_t i = 0; i < osprites.no_sprites; i++)
     {
@@ -155,6 +158,7 @@ void OLevelObjs::setup_sprite(oentry* sprite, uint32_t z)
     #define READ32(x) trackloader.read32(trackloader.scenerymap_data, x)
 
     sprite->control |= OSprites::ENABLE; // Turn sprite on
+    osprites.set_active(sprite);
     uint32_t addr = osprites.seg_spr_addr + osprites.seg_spr_offset1;
 
     // Set sprite x,y (world coordinates)
@@ -162,7 +166,7 @@ void OLevelObjs::setup_sprite(oentry* sprite, uint32_t z)
     sprite->xw2     = READ8(addr + 1) << 4;
     sprite->yw      = READ16(addr + 2) << 7;
     sprite->type    = ((uint8_t) READ8 (addr + 5)) << 2;
-    sprite->addr    = roms.rom0p->read32(outrun.adr.sprite_type_table + sprite->type);
+    sprite->addr    = roms.rom0p->read32n(outrun.adr.sprite_type_table + sprite->type);
 
     sprite->pal_src = READ8 (addr + 7);
     
@@ -282,97 +286,104 @@ void OLevelObjs::setup_sprite_routine(oentry* sprite)
     }
 }
 
+// Only entries in the active index are visited. They are visited in jump table order,
+// as the original game does, because routines interact: A collision resets the collision
+// counter for the entries that follow, and the sprite order lists are filled in turn.
 void OLevelObjs::do_sprite_routine()
 {
-    for (uint8_t i = 0; i < osprites.no_sprites; i++)
+    for (uint8_t i = osprites.next_active(0); i < osprites.no_sprites; i = osprites.next_active(i + 1))
     {
         oentry* sprite = &osprites.jump_table[i];
 
-        if (sprite->control & OSprites::ENABLE)
+        // Disabled since it was indexed
+        if (!(sprite->control & OSprites::ENABLE))
         {
-            switch (sprite->function_holder)
-            {
-                // Normal Sprite: (Possible With/Without Collision, Zoom 1)
-                case 0:
-                    if (sprite->yw == 0)
-                       sprite_normal(sprite, 1);
-                    else
-                       set_spr_zoom_priority(sprite, 1);
-                    break;
-
-                // Grass Sprite
-                case 1:
-                    sprite_grass(sprite);
-                    break;
-
-                // Sprite based clouds that span entire sky
-                case 2:
-                    sprite_clouds(sprite);
-                    break;
-
-                // Water on LHS of Stage 1
-                case 3:
-                    sprite_water(sprite);
-                    break;
-
-                // Start Lights & Base Pillar of Checkpoint Sign
-                case 4:
-                    sprite_lights(sprite);
-                    break;
-                
-                // 5 - Checkpoint (Bottom Of Sign)
-                case 5:
-                    set_spr_zoom_priority(sprite, 1);
-                    break;
-
-                // 6 - Checkpoint (Top Of Sign)
-                case 6:
-                    set_spr_zoom_priority(sprite, 1);
-                    // Have we passed the checkpoint?
-                    if (!(sprite->control & OSprites::ENABLE))
-                        oinitengine.checkpoint_marker = -1;
-                    break;
-
-                // Draw From Centre Collision Check
-                case 7:
-                    sprite_collision_z1c(sprite);
-                    break;
-
-                // Normal Sprite: (Collision, Zoom 2)
-                case 8:
-                    sprite_normal(sprite, 2);
-                    break;
-
-                // Wide Rocks on Stage 2
-                case 9:
-                    sprite_rocks(sprite);
-                    break;
-
-                // Sand Strips
-                case 10:
-                    do_thickness_sprite(sprite, outrun.adr.sprite_sand);
-                    break;
-
-                // Stone Strips
-                case 11:
-                    do_thickness_sprite(sprite, outrun.adr.sprite_stone);
-                    break;
-
-                // Mini-Tree (Stage 5, Level ID: 0x24)
-                case 12:
-                    sprite_minitree(sprite);
-                    break;
-                
-                // Track Debris on Stage 3a
-                case 13:
-                    sprite_debris(sprite);
-                    break;
-
-                // Sand (Again) - Used in end sequence #2
-                case 14:
-                    do_thickness_sprite(sprite, outrun.adr.sprite_sand);
-                    break;
-            }
+            osprites.clear_active(i);
+            continue;
+        }
+
+        switch (sprite->function_holder)
+        {
+            // Normal Sprite: (Possible With/Without Collision, Zoom 1)
+            case 0:
+                if (sprite->yw == 0)
+                   sprite_normal(sprite, 1);
+                else
+                   set_spr_zoom_priority(sprite, 1);
+                break;
+
+            // Grass Sprite
+            case 1:
+                sprite_grass(sprite);
+                break;
+
+            // Sprite based clouds that span entire sky
+            case 2:
+                sprite_clouds(sprite);
+                break;
+
+            // Water on LHS of Stage 1
+            case 3:
+                sprite_water(sprite);
+                break;
+
+            // Start Lights & Base Pillar of Checkpoint Sign
+            case 4:
+                sprite_lights(sprite);
+                break;
+            
+            // 5 - Checkpoint (Bottom Of Sign)
+            case 5:
+                set_spr_zoom_priority(sprite, 1);
+                break;
+
+            // 6 - Checkpoint (Top Of Sign)
+            case 6:
+                set_spr_zoom_priority(sprite, 1);
+                // Have we passed the checkpoint?
+                if (!(sprite->control & OSprites::ENABLE))
+                    oinitengine.checkpoint_marker = -1;
+                break;
+
+            // Draw From Centre Collision Check
+            case 7:
+                sprite_collision_z1c(sprite);
+                break;
+
+            // Normal Sprite: (Collision, Zoom 2)
+            case 8:
+                sprite_normal(sprite, 2);
+                break;
+
+            // Wide Rocks on Stage 2
+            case 9:
+                sprite_rocks(sprite);
+                break;
+
+            // Sand Strips
+            case 10:
+                do_thickness_sprite(sprite, outrun.adr.sprite_sand);
+                break;
+
+            // Stone Strips
+            case 11:
+                do_thickness_sprite(sprite, outrun.adr.sprite_stone);
+                break;
+
+            // Mini-Tree (Stage 5, Level ID: 0x24)
+            case 12:
+                sprite_minitree(sprite);
+                break;
+            
+            // Track Debris on Stage 3a
+            case 13:
+                sprite_debris(sprite);
+                break;
+
+            // Sand (Again) - Used in end sequence #2
+            case 14:
+                do_thickness_sprite(sprite, outrun.adr.sprite_sand);
+                break;
         }
     }
 }
@@ -380,6 +391,7 @@ void OLevelObjs::do_sprite_routine()
 // Source: 4048
 void OLevelObjs::sprite_normal(oentry *sprite, uint8_t zoom)
 {
+    PROFILE_ROUTINE(0x4048);
     // Omit collision check if we're already colliding with something
     if (sprite_collision_counter != 0 || (sprite->z >> 16) < 0x1B0)
     {
@@ -396,15 +408,15 @@ void OLevelObjs::sprite_normal(oentry *sprite, uint8_t zoom)
     // H-Flip - swap x co-ordinates
     if (sprite->control & OSprites::HFLIP)
     {
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
         x2 = -x2;
         x1 = -x1;
     }
     else
     {
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
     }
 
     // If off left hand side or off right hand side of screen
@@ -440,15 +452,15 @@ void OLevelObjs::sprite_lights(oentry *sprite)
     // H-Flip - swap x co-ordinates
     if (sprite->control & OSprites::HFLIP)
     {
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
         x2 = -x2;
         x1 = -x1;
     }
     else
     {
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
     }
 
     // If off left hand side or off right hand side of screen
@@ -546,6 +558,7 @@ void OLevelObjs::set_spr_zoom_priority(oentry *sprite, uint8_t zoom)
 // - Test For Collision
 void OLevelObjs::sprite_collision_z1c(oentry* sprite)
 {
+    PROFILE_ROUTINE(0x4828);
     // Omit collision check if we're already colliding with something
     if (sprite_collision_counter != 0 || (sprite->z >> 16) < 0x1B0)
     {
@@ -562,15 +575,15 @@ void OLevelObjs::sprite_collision_z1c(oentry* sprite)
     // H-Flip - swap x co-ordinates
     if (sprite-> control & OSprites::HFLIP)
     {
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
         x2 = -x2;
         x1 = -x1;
     }
     else
     {
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
     }
 
     int16_t centre = (x2 - x1) >> 1; // d0
@@ -737,7 +750,7 @@ void OLevelObjs::sprite_minitree(oentry* sprite)
     {
         // don't choose a custom frame
         sprite->zoom = (uint8_t) z; // Set Entry Number For Zoom Lookup Table
-        sprite->addr = roms.rom0p->read32(outrun.adr.sprite_minitree); // Set to first frame in table
+        sprite->addr = roms.rom0p->read32n(outrun.adr.sprite_minitree); // Set to first frame in table
     }
     // Use Table to alter sprite based on its y position.
     //
@@ -751,7 +764,7 @@ void OLevelObjs::sprite_minitree(oentry* sprite)
         z <<= 1; // Note we can't use original z16, so don't try to optimize this
         uint8_t offset = roms.rom0.read8(MAP_Y_TO_FRAME + z);
         sprite->zoom = roms.rom0.read8(MAP_Y_TO_FRAME + z + 1);
-        sprite->addr = roms.rom0p->read32(outrun.adr.sprite_minitree + offset);
+        sprite->addr = roms.rom0p->read32n(outrun.adr.sprite_minitree + offset);
     }
     // order_sprites
     osprites.do_spr_order_shadows(sprite);
@@ -776,15 +789,15 @@ void OLevelObjs::sprite_debris(oentry* sprite)
     // H-Flip - swap x co-ordinates
     if (sprite->control & OSprites::HFLIP)
     {
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
         x2 = -x2;
         x1 = -x1;
     }
     else
     {
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
     }
 
     // If off left hand side or off right hand side of screen
@@ -807,6 +820,7 @@ void OLevelObjs::sprite_debris(oentry* sprite)
 // Source: 0x4144
 void OLevelObjs::sprite_clouds(oentry* sprite)
 {
+    PROFILE_ROUTINE(0x4144);
     osprites.move_sprite(sprite, 1);
     uint16_t z16 = sprite->z >> 16;
 
@@ -870,14 +884,14 @@ void OLevelObjs::sprite_clouds(oentry* sprite)
     {
         // 421c
         sprite->zoom = (uint8_t) z; // Set Entry Number For Zoom Lookup Table
-        sprite->addr = roms.rom0p->read32(outrun.adr.sprite_cloud);
+        sprite->addr = roms.rom0p->read32n(outrun.adr.sprite_cloud);
     }
     else
     {
         // 41f8
         z <<= 1;
         uint8_t lookup_z = roms.rom0.read8(MOVEMENT_LOOKUP_Z + z);
-        sprite->addr = roms.rom0p->read32(outrun.adr.sprite_cloud + lookup_z);
+        sprite->addr = roms.rom0p->read32n(outrun.adr.sprite_cloud + lookup_z);
         sprite->zoom = roms.rom0.read8(MOVEMENT_LOOKUP_Z + z + 1);
     }
     // end
@@ -927,14 +941,14 @@ void OLevelObjs::do_thickness_sprite(oentry* sprite, const uint32_t sprite_table
     {
         //use_large_frame (don't choose a custom frame)
         sprite->zoom = (uint8_t) z; // Set Entry Number For Zoom Lookup Table
-        sprite->addr = roms.rom0p->read32(0x3C + sprite_table_address); // Set default frame for larger sprite
+        sprite->addr = roms.rom0p->read32n(0x3C + sprite_table_address); // Set default frame for larger sprite
     }
     else
     {
         // use custom frame for sprite
         sprite->zoom = 0x80; // cap sprite_z minimum to 0x80
         z = (z >> 1) & 0x3C; // Mask over lower 2 bits, so the frame aligns to a word
-        sprite->addr = roms.rom0p->read32(z + sprite_table_address); // Set Frame Data Based On Zoom Value
+        sprite->addr = roms.rom0p->read32n(z + sprite_table_address); // Set Frame Data Based On Zoom Value
     }
     // order_sprites
     osprites.do_spr_order_shadows(sprite);
@@ -972,15 +986,15 @@ void OLevelObjs::sprite_rocks(oentry *sprite)
     // H-Flip - swap x co-ordinates
     if (sprite->control & OSprites::HFLIP)
     {
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
         x2 = -x2;
         x1 = -x1;
     }
     else
     {
-        x1 = (int16_t) roms.rom0.read16(&offset_addr);
-        x2 = (int16_t) roms.rom0.read16(&offset_addr);
+        x1 = (int16_t) roms.rom0.read16n(&offset_addr);
+        x2 = (int16_t) roms.rom0.read16n(&offset_addr);
     }
 
     // If off left hand side or off right hand side of screen
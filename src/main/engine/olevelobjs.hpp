@@ -80,4 +80,4 @@ class OLevelObjs
         void set_spr_zoom_priority_rocks(oentry*, uint8_t);
 };
 
-extern OLevelObjs olevelobjs;
\ No newline at end of file
+extern ENGINE_GLOBAL OLevelObjs olevelobjs;
\ No newline at end of file
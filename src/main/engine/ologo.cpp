@@ -12,7 +12,7 @@
 #include "engine/outils.hpp"
 #include "engine/ologo.hpp"
 
-OLogo ologo;
+ENGINE_GLOBAL OLogo ologo;
 
 const uint8_t OLogo::bg_pal[] = { 0x9A, 0x9B, 0x9C, 0x9D, 0x9E, 0x9A, 0x9B, 0x9C };
 
@@ -18,7 +18,7 @@
 #include "engine/otraffic.hpp"
 #include "engine/ostats.hpp"
 
-OMap omap;
+ENGINE_GLOBAL OMap omap;
 
 // Position of Ferrari in Jump Table
 const uint8_t SPRITE_FERRARI = 25;
@@ -232,14 +232,15 @@ void OMap::load_sprites()
         oentry* sprite     = &osprites.jump_table[i];
         sprite->id         = i+1;
         sprite->control    = roms.rom0p->read8(&adr);
+        osprites.set_active(sprite);
         sprite->draw_props = roms.rom0p->read8(&adr);
         sprite->shadow     = roms.rom0p->read8(&adr);
         sprite->zoom       = roms.rom0p->read8(&adr);
-        sprite->pal_src    = (uint8_t) roms.rom0p->read16(&adr);
-        sprite->priority   = sprite->road_priority = roms.rom0p->read16(&adr);
-        sprite->x          = roms.rom0p->read16(&adr);
-        sprite->y          = roms.rom0p->read16(&adr);
-        sprite->addr       = roms.rom0p->read32(&adr);
+        sprite->pal_src    = (uint8_t) roms.rom0p->read16n(&adr);
+        sprite->priority   = sprite->road_priority = roms.rom0p->read16n(&adr);
+        sprite->x          = roms.rom0p->read16n(&adr);
+        sprite->y          = roms.rom0p->read16n(&adr);
+        sprite->addr       = roms.rom0p->read32n(&adr);
         sprite->counter    = 0;  
         
         adr += 4; // throw this address away
@@ -351,7 +352,7 @@ void OMap::draw_piece(oentry* sprite, uint32_t adr)
 
         adr += (map_pos << 3);
 
-        sprite->addr    = roms.rom0p->read32(adr);
+        sprite->addr    = roms.rom0p->read32n(adr);
         sprite->pal_src = roms.rom0p->read8(4 + adr);
         osprites.map_palette(sprite);
     }
@@ -372,8 +373,8 @@ void OMap::move_mini_car(oentry* sprite)
         int16_t pos = (map_stage1 < 4) ? map_pos : map_pos >> 1;
         pos <<= 1; // do not try to merge with previous line
 
-        sprite->x += roms.rom0.read16(movement_table + pos);
-        int16_t y_change = roms.rom0.read16(movement_table + pos + 0x40);
+        sprite->x += roms.rom0.read16n(movement_table + pos);
+        int16_t y_change = roms.rom0.read16n(movement_table + pos + 0x40);
         sprite->y -= y_change;
 
         if (y_change == 0)
@@ -7,6 +7,7 @@
     See license.txt for more details.
 ***************************************************************************/
 
+#include "main.hpp"
 #include "engine/oferrari.hpp"
 #include "engine/ohud.hpp"
 #include "engine/oinputs.hpp"
@@ -15,8 +16,9 @@
 #include "engine/otiles.hpp"
 #include "engine/otraffic.hpp"
 #include "engine/ostats.hpp"
+#include "savestate.hpp"
 
-OMusic omusic;
+ENGINE_GLOBAL OMusic omusic;
 
 OMusic::OMusic(void)
 {
@@ -31,6 +33,18 @@ OMusic::~OMusic(void)
     if (tile_patch) delete tile_patch;
 }
 
+// The widescreen tilemap is loaded once, so is kept rather than saved
+void OMusic::sync_state(StateBuf& state)
+{
+    RomLoader* tilemap    = this->tilemap;
+    RomLoader* tile_patch = this->tile_patch;
+
+    state.sync(*this);
+
+    this->tilemap    = tilemap;
+    this->tile_patch = tile_patch;
+}
+
 // Load Modified Widescreen version of tilemap
 bool OMusic::load_widescreen_map()
 {
@@ -313,12 +327,23 @@ void OMusic::tick()
         if (music_selected != last_music_selected)
         {
             if (preview_counter == 0 && last_music_selected != -1)
+            {
                 osoundint.queue_sound(sound::FM_RESET);
+                #ifdef COMPILE_SOUND_CODE
+                cannonball::audio.clear_wav();
+                #endif
+            }
 
             if (++preview_counter >= 10)
             {
                 preview_counter = 0;
-                osoundint.queue_sound(music_selected);
+                #ifdef COMPILE_SOUND_CODE
+                // Custom music is streamed, so starts without stalling the frame
+                if (music_selected >= 0 && music_selected <= 2)
+                    cannonball::audio.load_wav(config.sound.custom_music[music_selected].filename.c_str());
+                else
+                #endif
+                    osoundint.queue_sound(music_selected);
                 last_music_selected = music_selected;
             }
         
@@ -368,7 +393,7 @@ void OMusic::blit_music_select()
 
     // Write 32 Palette Longs to Palette RAM
     for (int i = 0; i < 32; i++)
-        video.write_pal32(&dst_addr, roms.rom0.read32(&src_addr));
+        video.write_pal32(&dst_addr, roms.rom0.read32n(&src_addr));
 
     // Set Tilemap Scroll
     otiles.set_scroll(config.s16_x_off);
@@ -406,7 +431,7 @@ void OMusic::blit_music_select()
             for (int x = 0; x < 40;)
             {
                 // get next tile
-                uint32_t data = roms.rom0.read16(&src_addr);
+                uint32_t data = roms.rom0.read16n(&src_addr);
                 // No Compression: write tile directly to tile ram
                 if (data != 0)
                 {
@@ -416,8 +441,8 @@ void OMusic::blit_music_select()
                 // Compression
                 else
                 {
-                    uint16_t value = roms.rom0.read16(&src_addr); // tile index to copy
-                    uint16_t count = roms.rom0.read16(&src_addr); // number of times to copy value
+                    uint16_t value = roms.rom0.read16n(&src_addr); // tile index to copy
+                    uint16_t count = roms.rom0.read16n(&src_addr); // number of times to copy value
 
                     for (uint16_t i = 0; i <= count; i++)
                     {
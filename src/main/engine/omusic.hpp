@@ -12,6 +12,7 @@
 #include "outrun.hpp"
 
 class RomLoader;
+class StateBuf;
 
 class OMusic
 {
@@ -28,6 +29,7 @@ public:
     void tick();
     void blit();
     void check_start();
+    void sync_state(StateBuf& state);
 
 private:
     // Modified Widescreen version of the Music Select Tilemap
@@ -49,5 +51,5 @@ private:
     void blit_music_select();
 };
 
-extern OMusic omusic;
+extern ENGINE_GLOBAL OMusic omusic;
 
@@ -12,8 +12,9 @@
 #include "engine/ohud.hpp"
 #include "engine/oinputs.hpp"
 #include "engine/opalette.hpp"
+#include "profiler.hpp"
 
-OPalette opalette;
+ENGINE_GLOBAL OPalette opalette;
 
 OPalette::OPalette(void)
 {
@@ -38,12 +39,12 @@ void OPalette::init()
 // Source: 8CA4
 void OPalette::setup_sky_palette()
 {
-    // Read Address of sky palette information from index
-    uint32_t src = trackloader.read_pal_sky_table(trackloader.current_level->pal_sky);
+    // Sky palette information, resolved from the index when the level was set up
+    const uint32_t* src = trackloader.current_level->sky;
     uint32_t dst = 0x120F00; // palette ram
 
     for (int16_t i = 0; i <= 0x1F; i++)
-        video.write_pal32(&dst, trackloader.read32(trackloader.pal_sky_data, &src));
+        video.write_pal32(&dst, src[i]);
 }
 
 // Setup data in RAM necessary for sky palette fade.
@@ -67,11 +68,11 @@ void OPalette::setup_sky_change()
 
     oinitengine.end_stage_props &= ~BIT_2; // Denote setup_sky_change done
 
-    // Address Of Sky Palette Entries for next stage
-    uint32_t src = trackloader.read_pal_sky_table(trackloader.get_level(stage_offset)->pal_sky);
+    // Sky Palette Entries for next stage
+    const uint32_t* src = trackloader.get_level(stage_offset)->sky;
 
     for (int16_t i = 0; i <= 0x1F; i++)
-        pal_manip[i + 0x3E0] = trackloader.read32(trackloader.pal_sky_data, &src);
+        pal_manip[i + 0x3E0] = src[i];
 
     sky_palette_init |= BIT_0; // Denote new sky palette setup
 
@@ -220,6 +221,7 @@ void OPalette::fade_sky_pal_entry(const uint16_t start_colour, const uint16_t en
 // Source: 0x8E20
 void OPalette::cycle_sky_palette()
 {
+    PROFILE_ROUTINE(0x8E20);
     if (!(sky_palette_init & BIT_1)) return;
     
     uint8_t d0 = ++cycle_counter;
@@ -257,6 +259,7 @@ void OPalette::cycle_sky_palette()
 // Source: 0x91F8
 void OPalette::fade_palette()
 {
+    PROFILE_ROUTINE(0x91F8);
     if (!(pal_manip_ctrl & BIT_0)) return;
 
     if (outrun.game_state != GS_ATTRACT && outrun.game_state != GS_INGAME) return;
@@ -412,12 +415,10 @@ void OPalette::write_next_pal_to_ram()
     pal_fade[dst] = next_level->palr1.stripe_centre >> 16;    dst += 9;
     pal_fade[dst] = next_level->palr1.stripe_centre & 0xFFFF; dst += 9;
     
-    // Ground Palette Entries (Index to table below)
-    uint32_t ground_pal_addr = trackloader.read_pal_gnd_table(next_level->pal_gnd);
-
+    // Ground Palette Entries
     for (int16_t i = 0; i <= 15; i++)
     {
-        pal_fade[dst] = trackloader.read16(trackloader.pal_gnd_data, &ground_pal_addr);
+        pal_fade[dst] = next_level->ground[i];
         dst += 9;
     }
 }
@@ -500,14 +501,14 @@ void OPalette::write_fade_to_palram()
 // Source: 8ED2
 void OPalette::setup_ground_color()
 {
-    // Read Address of ground palette information
-    uint32_t src = trackloader.read_pal_gnd_table(trackloader.current_level->pal_gnd);
+    // Ground palette information
+    const uint16_t* src = trackloader.current_level->ground;
     uint32_t dst_pal_ground1 = 0x120840; // palette ram: ground 1
     uint32_t dst_pal_ground2 = 0x120860; // palette ram: ground 2
 
     for (int16_t i = 0; i < 8; i++)
     {
-        uint32_t data = trackloader.read32(trackloader.pal_gnd_data, &src);
+        uint32_t data = ((uint32_t) src[i << 1] << 16) | src[(i << 1) + 1];
         video.write_pal32(&dst_pal_ground1, data);
         video.write_pal32(&dst_pal_ground2, data);
     }
@@ -86,4 +86,4 @@ private:
     void fade_sky_pal_entry(const uint16_t, const uint16_t, uint32_t);
 };
 
-extern OPalette opalette;
\ No newline at end of file
+extern ENGINE_GLOBAL OPalette opalette;
\ No newline at end of file
@@ -19,6 +19,7 @@
 ***************************************************************************/
 
 #include <stdint.h>
+#include <string.h>
 #include "globals.hpp"
 #include "roms.hpp"
 #include "trackloader.hpp"
@@ -29,8 +30,10 @@
 
 #include "engine/oroad.hpp"
 #include "engine/ostats.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 
-ORoad oroad;
+ENGINE_GLOBAL ORoad oroad;
 
 ORoad::ORoad(void)
 {
@@ -43,6 +46,8 @@ ORoad::~ORoad(void)
 
 void ORoad::tick()
 {
+    trace::Scope phase("oroad.tick");
+
     // Enhancement: Adjust View
     if (horizon_target != horizon_offset)
     {
@@ -136,6 +141,8 @@ void ORoad::init()
     y_addr = 0;
     scanline = 0;
     total_height = 0;
+    hscroll_valid   = false;
+    road_data_valid = false;
     // End of extra initialization code 
 
     stage_loaded = -1;
@@ -192,6 +199,7 @@ void ORoad::set_view_mode(uint8_t mode, bool snap)
 // Output:         None
 void ORoad::do_road()
 {
+    PROFILE_ROUTINE(0x1044);
     rotate_values();
     setup_road_x();
     setup_road_y();
@@ -326,6 +334,7 @@ void ORoad::setup_road_x()
         uint32_t addr = road_data_offset; // temporary hack for custom data
         set_tilemap_x(addr);
         setup_x_data(addr);
+        hscroll_valid = false;
     }
     setup_hscroll();
 }
@@ -483,6 +492,22 @@ void ORoad::set_tilemap_x(uint32_t addr)
 
 void ORoad::setup_hscroll()
 {
+    PROFILE_ROUTINE(0x180C);
+
+    // Enhancement: Skip when nothing has changed. For instance, when the car is stationary.
+    if (hscroll_valid &&
+        hscroll_ctrl     == road_ctrl &&
+        hscroll_width    == road_width_bak &&
+        hscroll_car_x    == car_x_bak &&
+        hscroll_camera_x == oinitengine.camera_x_off)
+        return;
+
+    hscroll_valid    = true;
+    hscroll_ctrl     = road_ctrl;
+    hscroll_width    = road_width_bak;
+    hscroll_car_x    = car_x_bak;
+    hscroll_camera_x = oinitengine.camera_x_off;
+
     switch (road_ctrl)
     {
         case ROAD_OFF:
@@ -1251,6 +1276,7 @@ void ORoad::set_y_horizon()
 // Source Address: 0x13B8
 void ORoad::set_horizon_y()
 {
+    PROFILE_ROUTINE(0x13B8);
     // ------------------------------------------------------------------------
     // Aspect correct road inclines
     // ------------------------------------------------------------------------
@@ -1367,6 +1393,17 @@ void ORoad::set_horizon_y()
 
 void ORoad::do_road_data()
 {
+    PROFILE_ROUTINE(0x1318);
+
+    // Enhancement: The source is often the same as last tick (flat road, or the car stationary).
+    // Last tick's output is still at road_p0, so copy it rather than parse the source again.
+    if (road_data_valid && memcmp(&road_y[road_p1], &road_y[road_p0], 0x200 * sizeof(int16_t)) == 0)
+    {
+        memcpy(&road_y[road_p1 + 0x280], &road_y[road_p0 + 0x280], 0x180 * sizeof(int16_t));
+        return;
+    }
+    road_data_valid = true;
+
     // Road data in RAM #1 [Destination] (Solid fill/index fill etc)
     // This is the final block of data to be output to road hardware
     uint32_t addr_dst = 0x400 + road_p1;        // [a0]
@@ -1487,6 +1524,7 @@ void ORoad::do_road_data()
 // Source Address: 0x14C8
 void ORoad::blit_roads()
 {
+    PROFILE_ROUTINE(0x14C8);
     const uint32_t road0_adr = 0x801C0;
     const uint32_t road1_adr = 0x803C0;
 
@@ -1525,56 +1563,22 @@ void ORoad::blit_roads()
 
 void ORoad::blit_road(uint32_t a0)
 {
-    uint32_t a2 = 0x400 + road_p2;
-
-    // Write 0x1A0 bytes total Src: (0x260 - 0x400) Dst: 0x1C0
-    for (int16_t i = 0; i <= 13; i++)
-    {
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-        a0 -= 2; hwroad.write16(a0, road_y[--a2]);
-    }
+    // Write 0x1C0 bytes total Src: (0x320 - 0x400) Dst: (a0 - 0x1C0) - a0
+    // The original copies backwards from the end. The order is the same, so copy it as one block.
+    const uint16_t LENGTH = 0xE0;
+    hwroad.write_block16(a0 - (LENGTH * 2), (const uint16_t*) &road_y[road_p2 + 0x400 - LENGTH], LENGTH);
 }
 
 void ORoad::output_hscroll(int16_t* src, uint32_t dst)
 {
-    const int32_t d6 = 0x654;
-    uint32_t src_addr = 0;
+    const int16_t d6 = 0x654;
+    uint16_t hscroll[ARRAY_LENGTH];
 
-    // Copy 16 bytes
-    for (int32_t i = 0; i <= 0x3F; i++)
-    {
-        int16_t d0h = -src[src_addr++] + d6;
-        int16_t d0l = -src[src_addr++] + d6;
-        int16_t d1h = -src[src_addr++] + d6;
-        int16_t d1l = -src[src_addr++] + d6;
-        int16_t d2h = -src[src_addr++] + d6;
-        int16_t d2l = -src[src_addr++] + d6;
-        int16_t d3h = -src[src_addr++] + d6;
-        int16_t d3l = -src[src_addr++] + d6;
-        hwroad.write16(&dst, d0h);
-        hwroad.write16(&dst, d0l);
-        hwroad.write16(&dst, d1h);
-        hwroad.write16(&dst, d1l);
-        hwroad.write16(&dst, d2h);
-        hwroad.write16(&dst, d2l);
-        hwroad.write16(&dst, d3h);
-        hwroad.write16(&dst, d3l);
-    }
+    // Kept to a simple loop the compiler can vectorise, then copied to road RAM in one block
+    for (uint16_t i = 0; i < ARRAY_LENGTH; i++)
+        hscroll[i] = d6 - src[i];
+
+    hwroad.write_block16(dst, hscroll, ARRAY_LENGTH);
 }
 
 // Copy Background Colour To Road.
@@ -1605,13 +1609,13 @@ void ORoad::copy_bg_color()
     // Copy 1K
     for (int i = 0; i < 32; i++)
     {
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
-        hwroad.write32(&dst, roms.rom1p->read32(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
+        hwroad.write32(&dst, roms.rom1p->read32n(&src));
     }
 }
@@ -260,6 +260,16 @@ private:
     int16_t scanline;
     int32_t total_height;
 
+    // Inputs to the last H-Scroll setup. It is only redone when these, or road_x, change.
+    bool hscroll_valid;
+    uint8_t hscroll_ctrl;
+    int16_t hscroll_width;
+    int16_t hscroll_car_x;
+    int16_t hscroll_camera_x;
+
+    // Road data at road_p0 was parsed from its source last tick, so can be reused if the source matches
+    bool road_data_valid;
+
     // MOVED FOR DEBUGGING PURPOSES ONLY!
     private:
 
@@ -318,4 +328,4 @@ private:
 	void copy_bg_color();
 };
 
-extern ORoad oroad;
\ No newline at end of file
+extern ENGINE_GLOBAL ORoad oroad;
\ No newline at end of file
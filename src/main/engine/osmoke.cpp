@@ -12,7 +12,7 @@
 #include "engine/olevelobjs.hpp"
 #include "engine/osmoke.hpp"
 
-OSmoke osmoke;
+ENGINE_GLOBAL OSmoke osmoke;
 
 OSmoke::OSmoke(void)
 {
@@ -63,7 +63,7 @@ void OSmoke::draw_ferrari_smoke(oentry *sprite)
 
     if (olevelobjs.spray_counter)
     {
-        tick_smoke_anim(sprite, 1, roms.rom0p->read32(outrun.adr.spray_data + olevelobjs.spray_type));
+        tick_smoke_anim(sprite, 1, roms.rom0p->read32n(outrun.adr.spray_data + olevelobjs.spray_type));
         return;
     }
 
@@ -77,7 +77,7 @@ void OSmoke::draw_ferrari_smoke(oentry *sprite)
 
     if (oferrari.is_slipping && oferrari.wheel_state == OFerrari::WHEELS_ON)
     {
-        tick_smoke_anim(sprite, 0, roms.rom0p->read32(outrun.adr.smoke_data + smoke_type_slip));
+        tick_smoke_anim(sprite, 0, roms.rom0p->read32n(outrun.adr.smoke_data + smoke_type_slip));
         return;
     }
 
@@ -87,7 +87,7 @@ void OSmoke::draw_ferrari_smoke(oentry *sprite)
 
     if (oferrari.wheel_state != OFerrari::WHEELS_ON)
     {
-        uint32_t smoke_adr = roms.rom0p->read32(outrun.adr.smoke_data + smoke_type_offroad);
+        uint32_t smoke_adr = roms.rom0p->read32n(outrun.adr.smoke_data + smoke_type_offroad);
 
         // Left Wheel Only
         if (sprite == &osprites.jump_table[OSprites::SPRITE_SMOKE2] && oferrari.wheel_state == OFerrari::WHEELS_LEFT_OFF)
@@ -114,7 +114,7 @@ void OSmoke::draw_ferrari_smoke(oentry *sprite)
     // Smoke from wheels
     else if (oferrari.car_state == OFerrari::CAR_SMOKE)
     {
-        tick_smoke_anim(sprite, 1, roms.rom0p->read32(outrun.adr.smoke_data + smoke_type_onroad));
+        tick_smoke_anim(sprite, 1, roms.rom0p->read32n(outrun.adr.smoke_data + smoke_type_onroad));
     }
     // Animation Sequence
     else
@@ -123,7 +123,7 @@ void OSmoke::draw_ferrari_smoke(oentry *sprite)
             sprite->type = sprite->xw1; // Copy frame number to type
         else
         {
-            tick_smoke_anim(sprite, 1, roms.rom0p->read32(outrun.adr.smoke_data + smoke_type_onroad));
+            tick_smoke_anim(sprite, 1, roms.rom0p->read32n(outrun.adr.smoke_data + smoke_type_onroad));
         }
     }
 }
@@ -288,7 +288,7 @@ void OSmoke::tick_smoke_anim(oentry* sprite, int8_t anim_ctrl, uint32_t addr)
     }
     // setup_smoke:
     uint16_t frame   = (sprite->xw1 & 7) << 3;
-    sprite->addr     = roms.rom0p->read32(addr + frame);
+    sprite->addr     = roms.rom0p->read32n(addr + frame);
     sprite->pal_src  = roms.rom0p->read8(addr + frame + 5);
     uint16_t smoke_z = roms.rom0p->read8(addr + frame + 4) + sprite->z;
     if (smoke_z > 0xFF) smoke_z = 0xFF;
@@ -12,6 +12,7 @@
     See license.txt for more details.
 ***************************************************************************/
 
+#include <string.h>
 #include "../trackloader.hpp"
 
 #include "engine/oanimseq.hpp"
@@ -21,17 +22,39 @@
 #include "engine/osprites.hpp"
 #include "engine/otraffic.hpp"
 #include "engine/ozoom_lookup.hpp"
+#include "savestate.hpp"
+#include "profiler.hpp"
 
-OSprites osprites;
+#ifdef USE_THREADS
+#include <mutex>
+static std::mutex frame_lock;
+#endif
+
+ENGINE_GLOBAL OSprites osprites;
+
+sprite_frame_t* OSprites::frame_table[2] = { NULL, NULL };
+const uint8_t* OSprites::frame_source[2] = { NULL, NULL };
 
 OSprites::OSprites(void)
 {
+    frames = NULL;
 }
 
 OSprites::~OSprites(void)
 {
 }
 
+// References to sprite entries are stored in a save state as an index into the jump table (-1 = none)
+void OSprites::sync_entry(StateBuf& state, oentry*& entry)
+{
+    int16_t index = entry == NULL ? -1 : (int16_t) (entry - jump_table);
+
+    state.sync(index);
+
+    if (state.loading())
+        entry = (index >= 0 && index < JUMP_ENTRIES_TOTAL) ? &jump_table[index] : NULL;
+}
+
 void OSprites::init()
 {
     // Set activated number of sprites based on config
@@ -41,19 +64,19 @@ void OSprites::init()
     for (uint16_t i = 0; i < 0x100; i++)
         pal_lookup[i] = 0;
 
-    for (uint16_t i = 0; i < 0x2000; i++)
-    {
-        sprite_order[i] = 0;
-        sprite_order2[i] = 0;
-    }
+    for (uint16_t i = 0; i < 0x200; i++)
+        priority_count[i] = 0;
 
     // Reset hardware entries
-    for (uint16_t i = 0; i < JUMP_ENTRIES_TOTAL; i++)
+    for (uint16_t i = 0; i <= SPRITES_MAX; i++)
         sprite_entries[i].init();
 
     for (uint8_t i = 0; i < SPRITE_ENTRIES; i++)
         jump_table[i].init(i);
 
+    for (uint8_t i = 0; i < sizeof(active) / sizeof(active[0]); i++)
+        active[i] = 0;
+
     // Ferrari + Passenger Sprites
     jump_table[SPRITE_FERRARI].init(SPRITE_FERRARI);        // Ferrari
     jump_table[SPRITE_PASS1].init(SPRITE_PASS1);
@@ -133,6 +156,50 @@ void OSprites::init()
     pal_copy_count      = 0;    
 }
 
+// Sprite frames are looked up by do_sprite for every visible object, every tick.
+// Decode every word aligned address once, so a lookup is a single array access.
+void OSprites::select_frames(bool jap)
+{
+    const RomLoader* rom = roms.rom0p;
+
+#ifdef USE_THREADS
+    // Engine contexts on other threads may be selecting the same table
+    std::lock_guard<std::mutex> guard(frame_lock);
+#endif
+
+    if (frame_table[jap ? 1 : 0] == NULL)
+        frame_table[jap ? 1 : 0] = new sprite_frame_t[FRAME_ROM_SIZE >> 1];
+
+    sprite_frame_t* table = frame_table[jap ? 1 : 0];
+
+    // Decode, unless already decoded from this ROM
+    if (frame_source[jap ? 1 : 0] != rom->rom)
+    {
+        const uint32_t length = rom->length < FRAME_ROM_SIZE ? rom->length : FRAME_ROM_SIZE;
+
+        for (uint32_t adr = 0; adr < FRAME_ROM_SIZE; adr += 2)
+        {
+            sprite_frame_t* f = &table[adr >> 1];
+
+            if (adr + 10 > length)
+            {
+                memset(f, 0, sizeof(sprite_frame_t));
+                continue;
+            }
+
+            const uint8_t* src = &rom->rom[adr];
+            f->width_lookup = src[1];
+            f->line_width   = (src[2] << 8) | src[3];
+            f->line_height  = (src[4] << 8) | src[5];
+            f->bank         = src[7];
+            f->offset       = (src[8] << 8) | src[9];
+        }
+        frame_source[jap ? 1 : 0] = rom->rom;
+    }
+
+    frames = table;
+}
+
 // Swap Sprite RAM And Update Palette Data
 void OSprites::update_sprites()
 {
@@ -210,6 +277,7 @@ void OSprites::tick()
 
 void OSprites::sprite_control()
 {
+    PROFILE_ROUTINE(0x3BEE);
     uint16_t pos = trackloader.read_scenery_pos();
 
     // Populate next road segment
@@ -305,7 +373,7 @@ void OSprites::copy_palette_data()
         // Move 28 Bytes from ROM to palette RAM
         for (uint16_t j = 0; j < 7; j++)
         {
-            video.write_pal32(&dst_addr, roms.rom0.read32(&src_addr));
+            video.write_pal32(&dst_addr, roms.rom0.read32n(&src_addr));
         }
     }
     pal_copy_count = 0; // All entries copied
@@ -328,6 +396,7 @@ void OSprites::copy_palette_data()
 
 void OSprites::map_palette(oentry* spr)
 {
+    PROFILE_ROUTINE(0x75EA);
     uint8_t pal = pal_lookup[spr->pal_src];
 
     // -----------------------------------
@@ -370,20 +439,24 @@ void OSprites::map_palette(oentry* spr)
 
 void OSprites::do_spr_order_shadows(oentry* input)
 {
+    PROFILE_ROUTINE(0x77A8);
+
+    // Original limits: The number of entries, and the sprites in each slot of the priority table.
+    // Otherwise, as many sprites as the hardware can draw.
+    const uint8_t limit = config.engine.sprite_limits ? JUMP_ENTRIES_TOTAL : SPRITES_MAX;
+
     // LayOut specific fix to avoid memory crash on over populated scenery segments
-    if (spr_cnt_main + spr_cnt_shadow >= JUMP_ENTRIES_TOTAL)
+    if (spr_cnt_main + spr_cnt_shadow >= limit)
         return;
 
-    // Use priority as lookup into table. Assume we're on boundaries of 0x10
-    uint16_t priority = (input->priority & 0x1FF) << 4;
-    uint8_t bytes_to_copy = sprite_order[priority];
+    const uint16_t priority = input->priority & 0x1FF;
 
-    // Maximum number of bytes we want to copy is 0x10
-    if (bytes_to_copy < 0xE)
+    // Sprites past the original limit for their priority are not drawn, but their shadows are
+    if (!config.engine.sprite_limits || priority_count[priority] < SPRITES_PER_PRIORITY)
     {
-        bytes_to_copy++;
-        sprite_order[priority] = bytes_to_copy;
-        sprite_order[priority + bytes_to_copy + 1] = input->jump_index; // put at offset +2
+        priority_count[priority]++;
+        order_priority[spr_cnt_main] = priority;
+        order_index[spr_cnt_main]    = input->jump_index;
         spr_cnt_main++;
     }
 
@@ -392,7 +465,7 @@ void OSprites::do_spr_order_shadows(oentry* input)
     if (!(input->control & SHADOW)) return;
 
     // LayOut specific fix to avoid memory crash on over populated scenery segments
-    if (spr_cnt_main + spr_cnt_shadow >= JUMP_ENTRIES_TOTAL)
+    if (spr_cnt_main + spr_cnt_shadow >= limit)
         return;
 
     input->dst_index = spr_cnt_shadow;
@@ -414,7 +487,7 @@ void OSprites::do_spr_order_shadows(oentry* input)
     }
     else
     {
-        input->addr = roms.rom0p->read32(outrun.adr.shadow_frames + 0x3C);
+        input->addr = roms.rom0p->read32n(outrun.adr.shadow_frames + 0x3C);
     }
 
     do_sprite(input);           // Create Shadowed Version Of Sprite For Hardware
@@ -434,59 +507,30 @@ void OSprites::do_spr_order_shadows(oentry* input)
 
 void OSprites::sprite_copy()
 {
+    PROFILE_ROUTINE(0x78B0);
     if (spr_cnt_main == 0)
     {
         finalise_sprites();
         return;
     }
 
-    if (spr_cnt_main + spr_cnt_shadow > 0x7F)
+    uint8_t sorted[SPRITES_MAX];
+    sort_sprite_order(sorted);
+
+    if (spr_cnt_main + spr_cnt_shadow > SPRITES_MAX)
     {
         spr_cnt_main = spr_cnt_shadow = 0;
         finalise_sprites();
         return;
     }
 
-    uint32_t spr_cnt_main_copy = spr_cnt_main;
-
-    // look up in sprite_order
-    int32_t src_addr = -0x10;
-
-    // copy to sprite_entries
-    uint32_t dst_index = 0;
-
-    // Get next relevant entry (number of bytes to copy, followed by indexes of sprites)
-    while (spr_cnt_main_copy != 0)
-    {
-        src_addr += 0x10;
-        uint8_t bytes_to_copy = sprite_order[src_addr]; // warning: actually reads a word here normally, so this is wrong
-
-        // Copy the required number of bytes
-        if (bytes_to_copy != 0)
-        {
-            int32_t src_offset = src_addr + 2;
-
-            do
-            {
-                // Sprite Index To Draw
-                sprite_order2[dst_index++] = sprite_order[src_offset++];                
-                if (--spr_cnt_main_copy == 0) break; // Loop continues until this is zero.
-            }
-            // Decrement number of bytes to copy
-            while (--bytes_to_copy != 0);
-        }
-
-        // Clear number of bytes to copy
-        sprite_order[src_addr] = 0; 
-    }
-
     // cont2:
     uint16_t cnt_shadow_copy = spr_cnt_shadow;
 
     // next_sprite
     for (uint16_t i = 0; i < spr_cnt_main; i++)
     {
-        uint16_t jump_index = sprite_order2[i];
+        uint16_t jump_index = sorted[i];
         oentry *entry = &jump_table[jump_index];
         entry->dst_index = cnt_shadow_copy;
         cnt_shadow_copy++;
@@ -496,6 +540,50 @@ void OSprites::sprite_copy()
     finalise_sprites();
 }
 
+// Order the sprites added this frame by priority, lowest first, and clear the priority counts.
+//
+// The original game swept its table of every priority value in turn. This is a two pass radix sort 
+// (low 5 bits, then high 4 bits) of the sprites added. It is stable, so sprites of the same priority 
+// are drawn in the order added, as before.
+void OSprites::sort_sprite_order(uint8_t* sorted)
+{
+    const uint16_t n = spr_cnt_main;
+    uint8_t by_low[SPRITES_MAX];
+    uint8_t pos[0x20];
+
+    // Low bits: Positions in order_priority
+    memset(pos, 0, sizeof(pos));
+    for (uint16_t i = 0; i < n; i++)
+    {
+        pos[order_priority[i] & 0x1F]++;
+        priority_count[order_priority[i]] = 0;
+    }
+    for (uint16_t i = 0, total = 0; i < 0x20; i++)
+    {
+        const uint8_t count = pos[i];
+        pos[i] = total;
+        total += count;
+    }
+    for (uint16_t i = 0; i < n; i++)
+        by_low[pos[order_priority[i] & 0x1F]++] = i;
+
+    // High bits: Jump table indexes of the sprites
+    memset(pos, 0, 0x10);
+    for (uint16_t i = 0; i < n; i++)
+        pos[order_priority[i] >> 5]++;
+    for (uint16_t i = 0, total = 0; i < 0x10; i++)
+    {
+        const uint8_t count = pos[i];
+        pos[i] = total;
+        total += count;
+    }
+    for (uint16_t i = 0; i < n; i++)
+    {
+        const uint8_t src = by_low[i];
+        sorted[pos[order_priority[src] >> 5]++] = order_index[src];
+    }
+}
+
 // Was originally labelled set_end_marker
 // 
 // Source Address: 0x7942
@@ -505,6 +593,7 @@ void OSprites::sprite_copy()
 
 void OSprites::finalise_sprites()
 {
+    PROFILE_ROUTINE(0x7942);
     sprite_count = spr_cnt_main + spr_cnt_shadow;
     
     // Set end sprite marker
@@ -530,6 +619,7 @@ void OSprites::finalise_sprites()
 
 void OSprites::blit_sprites()
 {
+    PROFILE_ROUTINE(0x97E4);
     uint32_t dst_addr = SPRITE_RAM;
 
     for (uint16_t i = 0; i <= sprite_count; i++)
@@ -576,6 +666,7 @@ void OSprites::blit_sprites()
 
 void OSprites::do_sprite(oentry* input)
 {
+    PROFILE_ROUTINE(0x94EC);
     input->control |= DRAW_SPRITE; // Display input sprite
 
     // Get Correct Output Entry
@@ -610,6 +701,7 @@ void OSprites::do_sprite(oentry* input)
     // There are 5 unique frames that are typically used for zoomed sprites.
     // which correspond to different screen sizes
     uint32_t src_offsets = input->addr + ZOOM_LOOKUP[index];
+    const sprite_frame_t* frame = &frames[(src_offsets >> 1) & ((FRAME_ROM_SIZE >> 1) - 1)];
 
     uint16_t d0 = input->draw_props | (input->zoom << 8);
     uint16_t top_bit = d0 & 0x8000;
@@ -623,9 +715,9 @@ void OSprites::do_sprite(oentry* input)
             d0 = lookup_mask;
         }
 
-        d0 = (d0 & 0xFF00) + roms.rom0p->read8(src_offsets + 1);
+        d0 = (d0 & 0xFF00) + frame->width_lookup;
         width = roms.rom0p->read8(WH_TABLE + d0);
-        d0 = (d0 & 0xFF00) + roms.rom0p->read8(src_offsets + 3);
+        d0 = (d0 & 0xFF00) + (frame->line_width & 0xFF);
         height = roms.rom0p->read8(WH_TABLE + d0);
     }
     // loc_9560:
@@ -634,12 +726,12 @@ void OSprites::do_sprite(oentry* input)
         d0 &= 0x7C00;
         uint16_t h = d0;
 
-        d0 = (d0 & 0xFF00) + roms.rom0p->read8(src_offsets + 1);
+        d0 = (d0 & 0xFF00) + frame->width_lookup;
         width = roms.rom0p->read8(WH_TABLE + d0);
         d0 &= 0xFF;
         width += d0;
         
-        h |= roms.rom0p->read8(src_offsets + 3);
+        h |= frame->line_width & 0xFF;
         height = roms.rom0p->read8(WH_TABLE + h);
         h &= 0xFF;
         height += h;
@@ -677,8 +769,8 @@ void OSprites::do_sprite(oentry* input)
     // Set Palette & Sprite Bank Information
     // -------------------------------------------------------------------------
     output->set_pal(input->pal_dst); // Set Sprite Colour Palette
-    output->set_offset(roms.rom0p->read16(src_offsets + 8)); // Set Offset within selected sprite bank
-    output->set_bank(roms.rom0p->read8(src_offsets + 7) << 1); // Set Sprite Bank Value
+    output->set_offset(frame->offset); // Set Offset within selected sprite bank
+    output->set_bank(frame->bank << 1); // Set Sprite Bank Value
 
     // -------------------------------------------------------------------------
     // Set Sprite Height
@@ -686,9 +778,9 @@ void OSprites::do_sprite(oentry* input)
     if (sprite_y1 < 256)
     {
         int16_t y_adj = -(sprite_y1 - 256);
-        y_adj *= roms.rom0p->read16(src_offsets + 2); // Width of line data (Unsigned multiply)
+        y_adj *= frame->line_width; // Width of line data (Unsigned multiply)
         y_adj /= height; // Unsigned divide
-        y_adj *= roms.rom0p->read16(src_offsets + 4); // Length of line data (Unsigned multiply)
+        y_adj *= frame->line_height; // Length of line data (Unsigned multiply)
         output->inc_offset(y_adj);
         output->data[0x0] = (output->data[0x0] & 0xFF00) | 0x100; // Mask on negative y index
         output->set_height((uint8_t) sprite_y2);
@@ -767,12 +859,12 @@ void OSprites::do_sprite(oentry* input)
     }
 
     // cont2:
-    set_hrender(input, output, roms.rom0p->read16(src_offsets + 4), width);
+    set_hrender(input, output, frame->line_height, width);
     
     // -------------------------------------------------------------------------
     // Set Sprite Pitch & Priority
     // -------------------------------------------------------------------------
-    output->set_pitch(roms.rom0p->read8(src_offsets + 5) << 1);
+    output->set_pitch((frame->line_height & 0xFF) << 1);
     output->set_priority(input->shadow << 4); // todo: where does this get set?
 }
 
@@ -897,7 +989,7 @@ void OSprites::set_hrender(oentry* input, osprite* output, uint16_t offset, uint
 void OSprites::move_sprite(oentry* sprite, uint8_t shift)
 {
     uint32_t addr = SPRITE_ZOOM_LOOKUP + (((sprite->z >> 16) << 2) | sprite_scroll_speed);
-    uint32_t value = roms.rom0.read32(addr) >> shift;
+    uint32_t value = roms.rom0.read32n(addr) >> shift;
 
     if (config.tick_fps == 60)
         value >>= 1;
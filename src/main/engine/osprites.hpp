@@ -18,6 +18,22 @@
 #include "osprite.hpp"
 #include "outrun.hpp"
 
+class StateBuf;
+class RomLoader;
+
+// Sprite frame descriptor, decoded from its big endian format in the 68000 program ROM.
+//
+// The descriptor's bytes overlap: The low byte of line_width is the height helper
+// lookup, and the low byte of line_height is the sprite pitch.
+struct sprite_frame_t
+{
+    uint16_t line_width;   // + 2 : [Word] Line Data Width
+    uint16_t line_height;  // + 4 : [Word] Line Data Height
+    uint16_t offset;       // + 8 : [Word] Offset Within Sprite Bank
+    uint8_t  width_lookup; // + 1 : [Byte] Width Helper Lookup
+    uint8_t  bank;         // + 7 : [Byte] Sprite Bank
+};
+
 class OSprites
 {
 public:
@@ -71,11 +87,25 @@ public:
 
     const static uint8_t SPRITE_FLAG  = SPRITE_ENTRIES + 21;    // Flag Man
 
+    // Sprites the hardware can draw in a frame: Sprite RAM holds 0x80 entries, including the end marker
+    const static uint8_t SPRITES_MAX = 0x7F;
+
+    // Original sprite order table: Sprites of a single priority (Not counting shadows)
+    const static uint8_t SPRITES_PER_PRIORITY = 0xE;
+
 	// Jump Table Sprite Entries
 	oentry jump_table[JUMP_ENTRIES_TOTAL]; 
 
-	// Converted sprite entries in RAM for hardware.
-	osprite sprite_entries[JUMP_ENTRIES_TOTAL];
+	// Converted sprite entries in RAM for hardware. Followed by the end marker.
+	osprite sprite_entries[SPRITES_MAX + 1];
+
+	// Decoded frames of the program ROM in use
+	const sprite_frame_t* frames;
+
+	// Index of level object entries (0 to SPRITE_ENTRIES) that may be enabled: Bit per entry.
+	// Set wherever a level object is enabled. Disabled entries are dropped by the next
+	// walk of the index, so an entry's control byte remains the definitive state.
+	uint32_t active[(SPRITE_ENTRIES + 31) >> 5];
 
 	// -------------------------------------------------------------------------
 	// Jump Table 2 Entries For Sprite Control
@@ -137,6 +167,45 @@ public:
 
     void move_sprite(oentry*, uint8_t);
 
+    void sync_entry(StateBuf& state, oentry*& entry);
+
+    // Add a level object entry to the index, once enabled
+    inline void set_active(const oentry* entry)
+    {
+        const uint8_t i = entry->jump_index;
+        if (i < SPRITE_ENTRIES)
+            active[i >> 5] |= 1 << (i & 31);
+    }
+
+    inline void clear_active(const uint8_t i)
+    {
+        active[i >> 5] &= ~(1 << (i & 31));
+    }
+
+    // Next indexed entry from i, in ascending order. SPRITE_ENTRIES if none.
+    inline uint8_t next_active(uint8_t i) const
+    {
+        while (i < SPRITE_ENTRIES)
+        {
+            uint32_t bits = active[i >> 5] >> (i & 31);
+            if (bits == 0)
+            {
+                i = (i | 31) + 1; // Skip to next word
+                continue;
+            }
+            while ((bits & 1) == 0)
+            {
+                bits >>= 1;
+                i++;
+            }
+            return i;
+        }
+        return SPRITE_ENTRIES;
+    }
+
+    // Use the sprite frames of the selected program ROM, decoding them on first use
+    void select_frames(bool jap);
+
 private:
 
 	// Start of Sprite RAM
@@ -145,6 +214,13 @@ private:
 	// Palette Ram: Sprite Entries Start Here
 	static const uint32_t PAL_SPRITES = 0x121000;
 
+	// Program ROM size, and the decoded frame descriptors at each (word aligned) address.
+	// Read-only once decoded, so shared by every engine context. Western and Japanese ROMs.
+	// Each table is allocated when its ROM is first selected.
+	static const uint32_t FRAME_ROM_SIZE = 0x40000;
+	static sprite_frame_t* frame_table[2];
+	static const uint8_t* frame_source[2];
+
 	// Denote whether to swap sprite ram
 	bool do_sprite_swap;
 
@@ -170,13 +246,19 @@ private:
 	// Palette Lookup Table
 	uint8_t pal_lookup[0x100];
 
-	// Converted sprite entries in RAM for hardware.
-	uint8_t sprite_order[0x2000];
-	uint8_t sprite_order2[0x2000];
+	// Sprites to draw this frame, in the order added, with their priority.
+	// The original game kept a table with a slot of 0x10 bytes for each priority value.
+	uint16_t order_priority[SPRITES_MAX];
+	uint8_t order_index[SPRITES_MAX];
+
+	// Sprites added at each priority this frame
+	uint8_t priority_count[0x200];
+
+	void sort_sprite_order(uint8_t* sorted);
 
     void sprite_control();
 	void hide_hwsprite(oentry*, osprite*);
 	void finalise_sprites();
 };
 
-extern OSprites osprites;
+extern ENGINE_GLOBAL OSprites osprites;
@@ -15,7 +15,7 @@
 #include "engine/ostats.hpp"
 #include "engine/otraffic.hpp"
 
-OStats ostats;
+ENGINE_GLOBAL OStats ostats;
 
 // Original buggy millisecond lookup table (Used when 64 frames = 1 second)
 // Conversion table from 0 to 64 -> Millisecond value
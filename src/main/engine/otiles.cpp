@@ -14,8 +14,9 @@
 #include "../trackloader.hpp"
 #include "engine/opalette.hpp"
 #include "engine/otiles.hpp"
+#include "profiler.hpp"
 
-OTiles otiles;
+ENGINE_GLOBAL OTiles otiles;
 
 OTiles::OTiles(void)
 {
@@ -68,7 +69,7 @@ void OTiles::setup_palette_hud()
     // Write longs of palette data. Read from ROM.
     for (int i = 0; i <= 0x1F; i++)
     {
-        video.write_pal32(&pal_addr, roms.rom0.read32(&src_addr));
+        video.write_pal32(&pal_addr, roms.rom0.read32n(&src_addr));
     }
 }
 
@@ -89,10 +90,10 @@ void OTiles::setup_palette_tilemap()
         uint32_t tile_data_addr = 0x17050 + offset;
         
         // Write 4 x longs of palette data. Read from ROM.
-        video.write_pal32(&pal_addr, roms.rom0.read32(&tile_data_addr));
-        video.write_pal32(&pal_addr, roms.rom0.read32(&tile_data_addr));
-        video.write_pal32(&pal_addr, roms.rom0.read32(&tile_data_addr));
-        video.write_pal32(&pal_addr, roms.rom0.read32(&tile_data_addr));
+        video.write_pal32(&pal_addr, roms.rom0.read32n(&tile_data_addr));
+        video.write_pal32(&pal_addr, roms.rom0.read32n(&tile_data_addr));
+        video.write_pal32(&pal_addr, roms.rom0.read32n(&tile_data_addr));
+        video.write_pal32(&pal_addr, roms.rom0.read32n(&tile_data_addr));
     }
 }
 
@@ -153,6 +154,7 @@ void OTiles::reset_tiles_pal()
 
 void OTiles::update_tilemaps(int8_t p)
 {
+    PROFILE_ROUTINE(0xD812);
     if (outrun.service_mode) return;
 
     page = p;
@@ -209,8 +211,8 @@ void OTiles::clear_tile_info()
     video.clear_tile_ram();
 
     // 4. Setup new values
-    fg_psel = roms.rom0.read16(TILES_PAGE_FG1);
-    bg_psel = roms.rom0.read16(TILES_PAGE_BG1);
+    fg_psel = roms.rom0.read16n(TILES_PAGE_FG1);
+    bg_psel = roms.rom0.read16n(TILES_PAGE_BG1);
     video.write_text16(HW_FG_PSEL, fg_psel);    // Also write values to hardware
     video.write_text16(HW_BG_PSEL, bg_psel);
 
@@ -233,9 +235,9 @@ void OTiles::init_tilemap(int16_t stage_id)
 
     fg_v_tiles    = roms.rom0p->read8(&addr);   // Write Default FG Tilemap Height
     bg_v_tiles    = roms.rom0p->read8(&addr);   // Write Default BG Tilemap Height
-    fg_addr       = roms.rom0p->read32(&addr);  // Write Default FG Tilemap Address
-    bg_addr       = roms.rom0p->read32(&addr);  // Write Default BG Tilemap Address
-    tilemap_v_off = roms.rom0p->read16(&addr);
+    fg_addr       = roms.rom0p->read32n(&addr);  // Write Default FG Tilemap Address
+    bg_addr       = roms.rom0p->read32n(&addr);  // Write Default BG Tilemap Address
+    tilemap_v_off = roms.rom0p->read16n(&addr);
     int16_t v_off = 0x68 - tilemap_v_off;
     oroad.horizon_y_bak = oroad.horizon_y2;
 
@@ -265,9 +267,9 @@ void OTiles::init_tilemap_props(uint16_t stage_id)
 
     fg_v_tiles    = roms.rom0p->read8(&addr);   // Write Default FG Tilemap Height
     bg_v_tiles    = roms.rom0p->read8(&addr);   // Write Default BG Tilemap Height
-    fg_addr       = roms.rom0p->read32(&addr);  // Write Default FG Tilemap Address
-    bg_addr       = roms.rom0p->read32(&addr);  // Write Default BG Tilemap Address
-    tilemap_v_off = roms.rom0p->read16(&addr);  // Set Tilemap v-scroll offset   
+    fg_addr       = roms.rom0p->read32n(&addr);  // Write Default FG Tilemap Address
+    bg_addr       = roms.rom0p->read32n(&addr);  // Write Default BG Tilemap Address
+    tilemap_v_off = roms.rom0p->read16n(&addr);  // Set Tilemap v-scroll offset   
 }
 
 
@@ -298,13 +300,13 @@ void OTiles::copy_fg_tiles(uint32_t dst_addr)
             // next_tilex:
             do
             {
-                uint32_t data = roms.rom0.read16(&src_addr);
+                uint32_t data = roms.rom0.read16n(&src_addr);
 
                 // Compression
                 if (data == 0)
                 {
-                    uint16_t value = roms.rom0.read16(&src_addr); // tile index to copy
-                    uint16_t count = roms.rom0.read16(&src_addr); // number of times to copy value
+                    uint16_t value = roms.rom0.read16n(&src_addr); // tile index to copy
+                    uint16_t count = roms.rom0.read16n(&src_addr); // number of times to copy value
                 
                     // copy_compressed:
                     for (uint16_t i = 0; i <= count; i++)
@@ -360,13 +362,13 @@ void OTiles::copy_bg_tiles(uint32_t dst_addr)
             // next_tilex:
             do
             {
-                uint32_t data = roms.rom0.read16(&src_addr);
+                uint32_t data = roms.rom0.read16n(&src_addr);
 
                 // Compression
                 if (data == 0)
                 {
-                    uint16_t value = roms.rom0.read16(&src_addr); // tile index to copy
-                    uint16_t count = roms.rom0.read16(&src_addr); // number of times to copy value
+                    uint16_t value = roms.rom0.read16n(&src_addr); // tile index to copy
+                    uint16_t count = roms.rom0.read16n(&src_addr); // number of times to copy value
                 
                     // copy_compressed:
                     for (uint16_t i = 0; i <= count; i++)
@@ -521,7 +523,7 @@ void OTiles::h_scroll_tilemaps()
     if (oinitengine.end_stage_props & BIT_0)
     {
         // Road position is used as an offset into the table. (Note it's reset at beginning of road split)
-        h_scroll_lookup = roms.rom0.read16(H_SCROLL_TABLE + ((oroad.road_pos >> 16) << 1));
+        h_scroll_lookup = roms.rom0.read16n(H_SCROLL_TABLE + ((oroad.road_pos >> 16) << 1));
         
         int32_t tilemap_h_target = h_scroll_lookup << 5;
         tilemap_h_target <<= 16;
@@ -617,7 +619,7 @@ void OTiles::update_fg_page()
     cur_stage &= 1;
     cur_stage *= 8;
     h += cur_stage;
-    fg_psel = roms.rom0.read16(TILES_PAGE_FG1 + h);
+    fg_psel = roms.rom0.read16n(TILES_PAGE_FG1 + h);
 }
 
 void OTiles::update_bg_page()
@@ -641,7 +643,7 @@ void OTiles::update_bg_page()
     cur_stage &= 1;
     cur_stage = ((cur_stage * 2) + cur_stage) << 1;
     h += cur_stage;
-    bg_psel = roms.rom0.read16(TILES_PAGE_BG1 + h);
+    bg_psel = roms.rom0.read16n(TILES_PAGE_BG1 + h);
 }
 
 // Initalize Next Tilemap. On Level Switch.
@@ -761,10 +763,10 @@ void OTiles::copy_to_palram(const uint8_t blocks, uint32_t src, uint32_t dst)
 {
     for (uint8_t i = 0; i <= blocks; i++)
     {
-        video.write_pal32(&dst, roms.rom0.read32(src));
-        video.write_pal32(&dst, roms.rom0.read32(src + 0x4));
-        video.write_pal32(&dst, roms.rom0.read32(src + 0x8));
-        video.write_pal32(&dst, roms.rom0.read32(src + 0xc));
+        video.write_pal32(&dst, roms.rom0.read32n(src));
+        video.write_pal32(&dst, roms.rom0.read32n(src + 0x4));
+        video.write_pal32(&dst, roms.rom0.read32n(src + 0x8));
+        video.write_pal32(&dst, roms.rom0.read32n(src + 0xc));
     }
 }
 
@@ -798,7 +800,7 @@ void OTiles::split_tilemaps()
 void OTiles::update_fg_page_split()
 {
     fg_h_scroll = tilemap_h_scr >> 16;
-    fg_psel = roms.rom0.read16(TILES_PAGE_FG2 + ((page & 1) ? 0x6 : 0xE));
+    fg_psel = roms.rom0.read16n(TILES_PAGE_FG2 + ((page & 1) ? 0x6 : 0xE));
 }
 
 // Setup Background tilemap, with relevant h-scroll and page information. Ready for forthcoming HW write.
@@ -807,7 +809,7 @@ void OTiles::update_fg_page_split()
 void OTiles::update_bg_page_split()
 {
     bg_h_scroll = (((tilemap_h_scr >> 16) & 0xFFF) * 3) >> 2;
-    bg_psel = roms.rom0.read16(TILES_PAGE_BG2 + ((page & 1) ? 0x4 : 0xA));
+    bg_psel = roms.rom0.read16n(TILES_PAGE_BG2 + ((page & 1) ? 0x4 : 0xA));
 }
 
 // Fill tilemap background with a solid color
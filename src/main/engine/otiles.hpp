@@ -118,5 +118,5 @@ private:
     void update_bg_page_split();
 };
 
-extern OTiles otiles;
+extern ENGINE_GLOBAL OTiles otiles;
 
@@ -18,8 +18,10 @@
 #include "engine/outils.hpp"
 #include "engine/ostats.hpp"
 #include "engine/otraffic.hpp"
+#include "savestate.hpp"
+#include "profiler.hpp"
 
-OTraffic otraffic;
+ENGINE_GLOBAL OTraffic otraffic;
 
 OTraffic::OTraffic(void)
 {
@@ -30,6 +32,14 @@ OTraffic::~OTraffic(void)
 {
 }
 
+void OTraffic::sync_state(StateBuf& state)
+{
+    state.sync(*this);
+
+    for (int i = 0; i < 9; i++)
+        osprites.sync_entry(state, traffic_adr[i]);
+}
+
 void OTraffic::init()
 {
     ai_traffic        = 0;
@@ -101,6 +111,7 @@ void OTraffic::init_stage1_traffic()
 // Source: 0x521A
 void OTraffic::tick()
 {
+    PROFILE_ROUTINE(0x521A);
     // Lock traffic spawning to 30fps frame rate.
     if (outrun.tick_frame) 
         spawn_traffic();
@@ -259,6 +270,7 @@ void OTraffic::spawn_car(oentry* sprite)
 // Source: 0x4DAA
 void OTraffic::tick_spawned_sprite(oentry* sprite)
 {
+    PROFILE_ROUTINE(0x4DAA);
     if (outrun.tick_frame)
     {
         // Force side of road when in bonus mode, or road splitting
@@ -521,7 +533,7 @@ void OTraffic::update_props(oentry* sprite)
     sprite->pal_src = roms.rom0p->read8(outrun.adr.traffic_props + sprite->type + 4) + traffic_pal_cycle;
 
     int16_t traffic_type = (roms.rom0p->read8(outrun.adr.traffic_props + sprite->type + 7) << 5) + (traffic_frame << 2) + incline;
-    sprite->addr = roms.rom0p->read32(outrun.adr.traffic_data + traffic_type);
+    sprite->addr = roms.rom0p->read32n(outrun.adr.traffic_data + traffic_type);
 
     osprites.map_palette(sprite);
     traffic_speed_total += sprite->traffic_speed;
@@ -631,6 +643,7 @@ void OTraffic::set_max_traffic()
 // Source: 0x7990
 void OTraffic::traffic_logic()
 {
+    PROFILE_ROUTINE(0x7990);
     uint16_t sprite_count = osprites.sprite_count - osprites.spr_cnt_shadow;
     uint16_t spawned = 0; // d5
     
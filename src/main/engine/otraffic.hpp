@@ -14,6 +14,8 @@
 
 #include "outrun.hpp"
 
+class StateBuf;
+
 class OTraffic
 {
 public:
@@ -44,6 +46,7 @@ public:
     void set_max_traffic();
     void traffic_logic();
     void traffic_sound();
+    void sync_state(StateBuf& state);
 
 private:
 	// -------------------------------------------------------------------------
@@ -97,4 +100,4 @@ private:
     void check_collision(oentry* sprite);
 };
 
-extern OTraffic otraffic;
\ No newline at end of file
+extern ENGINE_GLOBAL OTraffic otraffic;
\ No newline at end of file
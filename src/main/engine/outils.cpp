@@ -7,14 +7,9 @@
     Copyright Chris White.
     See license.txt for more details.
 ***************************************************************************/
-#include <cstdlib> 
 #include "engine/outils.hpp"
 #include "engine/ostats.hpp"
 
-#ifdef __PS3__
-#define rand std::rand
-#endif
-
 outils::outils(void)
 {
 
@@ -31,20 +26,61 @@ outils::~outils(void)
 // Output:         Long Random
 
 // Seed for random number generator
-static uint32_t rnd_seed = 0;
+static ENGINE_GLOBAL uint32_t rnd_seed = 0;
 
 void outils::reset_random_seed()
 {
     rnd_seed = 0;
 }
 
+uint32_t outils::get_random_seed()
+{
+    return rnd_seed;
+}
+
+void outils::set_random_seed(uint32_t seed)
+{
+    rnd_seed = seed;
+}
+
+// Engine owned generator, in place of the C library rand(). 
+// Part of the engine state, so a run from the same seed matches on every platform.
+static const uint32_t ENTROPY_SEED = 0x9E3779B9;
+static ENGINE_GLOBAL uint32_t entropy_state = ENTROPY_SEED;
+
+void outils::reset_entropy()
+{
+    entropy_state = ENTROPY_SEED;
+}
+
+uint32_t outils::get_entropy()
+{
+    return entropy_state;
+}
+
+void outils::set_entropy(uint32_t seed)
+{
+    entropy_state = seed ? seed : ENTROPY_SEED; // Generator is stuck at 0
+}
+
+// Xorshift. Returns 31 bits, in the range of rand().
+uint32_t outils::entropy()
+{
+    uint32_t x = entropy_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    entropy_state = x;
+    return x & 0x7FFFFFFF;
+}
+
 uint32_t outils::random()
 {
 	// New seed value
 	uint32_t seed = rnd_seed;
 
 	if (seed == 0)
-        seed = config.engine.randomgen ? 0x2A6D365A : rand();
+        seed = config.engine.randomgen ? 0x2A6D365A : entropy();
 
 	// Random Value To Return
 	uint32_t rnd = seed;
@@ -21,7 +21,13 @@ public:
 	~outils();
 
     static void reset_random_seed();
+    static uint32_t get_random_seed();
+    static void set_random_seed(uint32_t);
 	static uint32_t random();
+    static void reset_entropy();
+    static uint32_t get_entropy();
+    static void set_entropy(uint32_t);
+    static uint32_t entropy();
 	static int32_t isqrt(int32_t);
     static uint16_t convert16_dechex(uint16_t);
     static uint32_t bcd_add(uint32_t, uint32_t);
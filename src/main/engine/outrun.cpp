@@ -36,8 +36,10 @@
 #include "engine/otraffic.hpp"
 #include "engine/outils.hpp"
 #include "cannonboard/interface.hpp"
+#include "profiler.hpp"
+#include "trace.hpp"
 
-Outrun outrun;
+ENGINE_GLOBAL Outrun outrun;
 
 /*
     Known Core Engine Issues:
@@ -78,6 +80,7 @@ void Outrun::init()
     video.clear_text_ram();
 
     tick_counter = 0;
+    vint_counter = 0;
 
     // CannonBoard Config: When Used in original cabinet
     if (config.cannonboard.enabled && config.cannonboard.cabinet == config.cannonboard.CABINET_MOVING)
@@ -98,6 +101,8 @@ void Outrun::boot()
     oinitengine.init(cannonball_mode == MODE_TTRIAL ? ttrial.level : 0);
     osoundint.init();
     outils::reset_random_seed(); // Ensure we match the genuine boot up of the original game each time
+    if (config.engine.deterministic)
+        outils::reset_entropy();
 }
 
 void Outrun::tick(Packet* packet, bool tick_frame)
@@ -107,6 +112,7 @@ void Outrun::tick(Packet* packet, bool tick_frame)
     if (tick_frame)
     {
         tick_counter++;
+        PROFILE_TICK();
 
         if (game_state >= GS_START1 && game_state <= GS_INGAME)
         {
@@ -174,11 +180,14 @@ void Outrun::tick(Packet* packet, bool tick_frame)
 // Vertical Interrupt
 void Outrun::vint()
 {
+    trace::Scope phase("outrun.vint");
+
     otiles.write_tilemap_hw();
     osprites.update_sprites();
     otiles.update_tilemaps(cannonball_mode == MODE_ORIGINAL ? ostats.cur_stage : 0);
 
-    if (config.fps < 120 || (cannonball::frame & 1))
+    // Counted here rather than using the frame counter, which also runs in the menu and while paused
+    if (config.fps < 120 || (++vint_counter & 1))
     {
         opalette.cycle_sky_palette();
         opalette.fade_palette();
@@ -192,6 +201,8 @@ void Outrun::vint()
 
 void Outrun::jump_table(Packet* packet)
 {
+    trace::Scope phase("outrun.jump_table");
+
     if (tick_frame && game_state != GS_CALIBRATE_MOTOR)
     {
         main_switch();                  // Address #1 (0xB128) - Main Switch
@@ -326,6 +337,7 @@ void Outrun::jump_table(Packet* packet)
 // Source: 0xB15E
 void Outrun::main_switch()
 {
+    PROFILE_ROUTINE(0xB15E);
     switch (game_state)
     {
         case GS_INIT:  
@@ -1073,6 +1085,7 @@ void Outrun::select_course(bool jap, bool prototype)
     }
 
     trackloader.init(jap);
+    osprites.select_frames(jap);
 
     // Use Prototype Coconut Beach Track
     trackloader.stage_data[0] = prototype ? 0x3A : 0x3C;
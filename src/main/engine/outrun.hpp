@@ -207,6 +207,9 @@ public:
     // Tick Counter (always syncd to 30 fps to flash text and other stuff)
     uint32_t tick_counter;
 
+    // Vertical interrupt counter. Used to run some interrupt code at half rate in 120 fps mode.
+    uint32_t vint_counter;
+
     // Main game state
     int8_t game_state;
 
@@ -245,4 +248,4 @@ private:
     void check_freeplay_start();
 };
 
-extern Outrun outrun;
+extern ENGINE_GLOBAL Outrun outrun;
@@ -0,0 +1,280 @@
+/***************************************************************************
+    Engine Context.
+
+    An independent copy of the game engine, running on its own thread, for
+    simulation farms that want one game per core in a single process.
+
+    See enginecontext.hpp for details.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <string.h>
+
+#include "main.hpp"
+#include "roms.hpp"
+#include "video.hpp"
+#include "enginecontext.hpp"
+#include "libretro/input.hpp"
+#include "engine/ocrash.hpp"
+#include "engine/oferrari.hpp"
+#include "engine/oinitengine.hpp"
+#include "engine/oinputs.hpp"
+#include "engine/omusic.hpp"
+#include "engine/oroad.hpp"
+#include "engine/ostats.hpp"
+#include "engine/audio/osoundint.hpp"
+
+EngineContext::EngineContext()
+{
+    cannonball_mode = Outrun::MODE_ORIGINAL;
+    memset(&ttrial, 0, sizeof(ttrial));
+    wheel           = 0x80;
+    accel           = 0;
+    brake           = 0;
+    buttons         = 0;
+    ticks_requested = 0;
+    ticks_done      = 0;
+    memset(&result, 0, sizeof(result));
+
+#if defined(ENGINE_TLS) && defined(USE_THREADS)
+    thread  = NULL;
+    status  = IDLE;
+    init_ok = false;
+#endif
+}
+
+EngineContext::~EngineContext()
+{
+#if defined(ENGINE_TLS) && defined(USE_THREADS)
+    if (thread != NULL)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            status = QUIT;
+            cv.notify_all();
+        }
+        thread->join();
+        delete thread;
+    }
+#endif
+}
+
+void EngineContext::next_frame()
+{
+    cannonball::frame++;
+
+    switch (config.fps)
+    {
+    case 60:
+        // Non-standard: tick every second frame
+        cannonball::tick_frame = cannonball::frame & 1;
+        break;
+    case 120:
+        // Non-standard: tick every fourth frame
+        cannonball::tick_frame = (cannonball::frame & 3) == 1;
+        break;
+    case 30:
+    default:
+        // Standard rate: tick every frame
+        cannonball::tick_frame = true;
+        break;
+    }
+}
+
+void EngineContext::get_telemetry(struct cannonball_telemetry* t)
+{
+    t->tick       = outrun.tick_counter;
+    t->game_state = outrun.game_state;
+    t->stage      = ostats.cur_stage;
+    t->time       = ostats.time_counter;
+    t->score      = ostats.score;
+    t->road_pos   = oroad.road_pos;
+    t->car_x      = oinitengine.car_x_pos;
+    t->road_width = oroad.road_width >> 16;
+    t->speed      = oinitengine.car_increment >> 16;
+    t->revs       = oferrari.revs;
+    t->gear       = oinputs.gear;
+    t->wheels_off = oferrari.wheel_state;
+    t->slipping   = oferrari.is_slipping;
+    t->crashed    = ocrash.crash_state;
+    t->steering   = oinputs.steering_adjust;
+    t->accel      = oinputs.acc_adjust;
+    t->brake      = oinputs.brake_adjust;
+}
+
+#if defined(ENGINE_TLS) && defined(USE_THREADS)
+
+// Engine initialisation touches the shared ROM paging, so contexts start one at a time
+static std::mutex init_lock;
+
+bool EngineContext::start()
+{
+    if (thread != NULL)
+        return false;
+
+    // Settings of the calling thread's engine
+    settings        = config;
+    cannonball_mode = outrun.cannonball_mode;
+    ttrial          = outrun.ttrial;
+
+    std::unique_lock<std::mutex> guard(lock);
+    status = RUNNING;
+    thread = new std::thread(&EngineContext::thread_loop, this);
+
+    while (status == RUNNING)
+        cv.wait(guard);
+
+    return init_ok;
+}
+
+void EngineContext::set_controls(int wheel, int accel, int brake, uint32_t buttons)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    this->wheel   = wheel;
+    this->accel   = accel;
+    this->brake   = brake;
+    this->buttons = buttons;
+}
+
+void EngineContext::run(uint32_t ticks)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (!init_ok || status != IDLE)
+        return;
+
+    ticks_requested = ticks;
+    ticks_done      = 0;
+    status          = RUNNING;
+    cv.notify_all();
+}
+
+uint32_t EngineContext::wait(struct cannonball_telemetry* telemetry)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (status == RUNNING)
+        cv.wait(guard);
+
+    if (telemetry)
+        *telemetry = result;
+    return ticks_done;
+}
+
+void EngineContext::thread_loop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+
+    init_ok = init_engine();
+    status  = IDLE;
+    cv.notify_all();
+
+    while (init_ok)
+    {
+        while (status == IDLE)
+            cv.wait(guard);
+
+        if (status == QUIT)
+            break;
+
+        for (uint32_t i = 0; i < sizeof(input.keys); i++)
+            input.keys[i] = (buttons >> i) & 1;
+        input.a_wheel = wheel;
+        input.a_accel = accel;
+        input.a_brake = brake;
+        const uint32_t ticks = ticks_requested;
+
+        guard.unlock();
+        const uint32_t done = run_engine(ticks);
+        guard.lock();
+
+        ticks_done = done;
+        get_telemetry(&result);
+        if (status == RUNNING)
+            status = IDLE;
+        cv.notify_all();
+    }
+}
+
+// Runs on the context's thread, so everything here is this context's engine
+bool EngineContext::init_engine()
+{
+    std::lock_guard<std::mutex> guard(init_lock);
+
+    config = settings;
+
+    // Nothing is drawn or played, and the player's files and force feedback are left alone.
+    // Widescreen would patch the shared tile graphics.
+    config.video.widescreen    = 0;
+    config.video.hires         = 0;
+    config.sound.enabled       = 0;
+    config.controls.haptic     = 0;
+    config.cannonboard.enabled = 0;
+    config.write_scores        = false;
+
+    outrun.cannonball_mode = cannonball_mode;
+    outrun.ttrial          = ttrial;
+
+    // The graphics were decoded by the default engine, so this only sets up the video hardware
+    omusic.load_widescreen_map();
+    if (!video.init(&roms, &config.video))
+        return false;
+
+    // Analog controls, set directly
+    input.analog  = 1;
+    input.gamepad = true;
+    input.a_wheel = 0x80;
+
+    oinputs.init();
+    outrun.init();
+    cannonball::state = cannonball::STATE_GAME;
+    return true;
+}
+
+// As the headless simulation of the default engine (see cannonball_sim_run)
+uint32_t EngineContext::run_engine(uint32_t ticks)
+{
+    uint32_t done = 0;
+
+    while (done < ticks && cannonball::state == cannonball::STATE_GAME)
+    {
+        next_frame();
+
+        if (cannonball::tick_frame)
+        {
+            oinputs.tick(NULL);
+            oinputs.do_gear();
+        }
+
+        outrun.tick(NULL, cannonball::tick_frame);
+
+#ifdef COMPILE_SOUND_CODE
+        osoundint.tick(0);
+#endif
+
+        if (cannonball::tick_frame)
+        {
+            input.frame_done();
+            done++;
+        }
+    }
+
+    return done;
+}
+
+#else
+
+bool EngineContext::start()
+{
+    return false;
+}
+
+void EngineContext::set_controls(int wheel, int accel, int brake, uint32_t buttons) {}
+void EngineContext::run(uint32_t ticks) {}
+
+uint32_t EngineContext::wait(struct cannonball_telemetry* telemetry)
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,93 @@
+/***************************************************************************
+    Engine Context.
+
+    An independent copy of the game engine, running on its own thread, for
+    simulation farms that want one game per core in a single process.
+
+    The engine is built from singletons (outrun, oroad, video, config...)
+    that reference each other directly. When built with ENGINE_TLS, these
+    are thread local: Each thread has its own engine, and the core's main
+    thread keeps the default instance used for normal play. A context
+    owns a thread, and with it a complete set of subsystems.
+
+    The ROMs and the decoded tile, sprite and road graphics are read-only
+    once loaded, and are shared by every context. Contexts never draw,
+    and run the sound program without the sound chips, as the headless
+    simulation does.
+
+    Without ENGINE_TLS, start() fails and only the default engine exists.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "frontend/config.hpp"
+#include "engine/outrun.hpp"
+#include "cannonball_api.h"
+
+#if defined(ENGINE_TLS) && defined(USE_THREADS)
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+class EngineContext
+{
+public:
+    EngineContext();
+    ~EngineContext();
+
+    // Start a new engine, with the calling thread's settings. It boots as a new game would,
+    // into attract mode. Call from the thread that owns the default engine, once a game is loaded.
+    bool start();
+
+    // Controls to hold from the next run onwards.
+    // Buttons: Bit per Input::presses.
+    void set_controls(int wheel, int accel, int brake, uint32_t buttons);
+
+    // Run the given number of engine ticks. Returns immediately: Call wait() for the result.
+    void run(uint32_t ticks);
+
+    // Wait for the run to finish. Returns the number of ticks run, which is short
+    // when the game leaves play (e.g. the end of a time trial).
+    uint32_t wait(struct cannonball_telemetry* telemetry);
+
+    // Helpers shared with the default engine. These act on the calling thread's engine.
+
+    // Advance the frame counter, and decide whether the game logic ticks this frame
+    static void next_frame();
+
+    // State of the player's car after the latest tick
+    static void get_telemetry(struct cannonball_telemetry* telemetry);
+
+private:
+    // Copied from the default engine by start()
+    Config settings;
+    uint8_t cannonball_mode;
+    time_trial_t ttrial;
+
+    // Controls, set by the owner
+    int wheel, accel, brake;
+    uint32_t buttons;
+
+    uint32_t ticks_requested;
+    uint32_t ticks_done;
+    struct cannonball_telemetry result;
+
+#if defined(ENGINE_TLS) && defined(USE_THREADS)
+    std::thread* thread;
+    std::mutex lock;
+    std::condition_variable cv;
+
+    enum { IDLE, RUNNING, QUIT };
+    int status;
+    bool init_ok;
+
+    void thread_loop();
+    bool init_engine();
+    uint32_t run_engine(uint32_t ticks);
+#endif
+};
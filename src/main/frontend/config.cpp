@@ -40,11 +40,11 @@ typedef boost::property_tree::xml_writer_settings<std::string> xml_writer_settin
 typedef boost::property_tree::xml_writer_settings<char> xml_writer_settings;
 #endif
 
-Config config;
+ENGINE_GLOBAL Config config;
 
 Config::Config(void)
 {
-
+    write_scores = true;
 }
 
 
@@ -98,6 +98,9 @@ void Config::load_scores(const std::string &filename)
 
 void Config::save_scores(const std::string &filename)
 {
+    if (!write_scores)
+        return;
+
     // Create empty property tree object
     ptree pt;
         
@@ -158,6 +161,9 @@ void Config::load_tiletrial_scores()
 
 void Config::save_tiletrial_scores()
 {
+    if (!write_scores)
+        return;
+
     const std::string filename = FILENAME_TTRIAL;
 
     // Create empty property tree object
@@ -13,6 +13,7 @@
 #include <stdint.h>
 #include <set>
 #include <string>
+#include "globals.hpp"
 
 struct custom_music_t
 {
@@ -46,6 +47,7 @@ struct video_settings_t
     int widescreen;
     int fps;
     int fps_count;
+    int refresh;   // Display rate for interpolated frames, when above the engine rate. 0 = Off
     int hires;
     int filtering;
 };
@@ -56,6 +58,9 @@ struct sound_settings_t
     int advertise;
     int preview;
     int fix_samples;
+    int threaded;    // Run sound program code and chips on a separate thread
+    int rate;        // Output sample rate (22050, 32000, 44100 or 48000)
+    int rate_control;// Adjust samples per frame using the frontend's audio buffer occupancy
     custom_music_t custom_music[4];
 };
 
@@ -109,9 +114,11 @@ struct engine_settings_t
     bool fix_bugs;
     bool fix_bugs_backup;
     bool fix_timer;
+    bool sprite_limits; // Drop sprites past the original game's limits
     bool layout_debug;
     bool force_ai;
     int new_attract;
+    int deterministic; // Fixed seeds, so runs with the same input always match
     
 };
 
@@ -141,6 +148,9 @@ public:
     // Continuous Mode: Traffic Setting
     int cont_traffic;
 
+    // Scores are written to disk. Engine contexts share the player's score files, and leave them alone.
+    bool write_scores;
+
     Config(void);
     ~Config(void);
 
@@ -155,4 +165,4 @@ public:
 private:
 };
 
-extern Config config;
+extern ENGINE_GLOBAL Config config;
@@ -9,6 +9,15 @@
 // Comment out to disable SDL specific sound code
 #define COMPILE_SOUND_CODE 1
 
+// Storage for the engine's singletons. With ENGINE_TLS defined, each thread has its own copy of 
+// the engine, so several engine contexts can run side by side (see enginecontext.hpp).
+// Off by default, as every access to a singleton then goes through a thread local lookup.
+#ifdef ENGINE_TLS
+#define ENGINE_GLOBAL thread_local
+#else
+#define ENGINE_GLOBAL
+#endif
+
 // ------------------------------------------------------------------------------------------------
 // General useful stuff
 // ------------------------------------------------------------------------------------------------
@@ -20,6 +29,20 @@ const uint16_t S16_HEIGHT     = 224;
 // Internal Widescreen Width
 const uint16_t S16_WIDTH_WIDE = 398;
 
+// Interpolated frames: Weight of the latest frame, when blended with the one before it
+const uint16_t BLEND_ONE = 0x100;
+
+// Blend between two values that wrap at (mask + 1), the shorter way round.
+// Returns -1 when they are further apart than max_delta, and shouldn't be blended.
+inline int32_t blend_wrap(uint16_t from, uint16_t to, uint16_t mask, int32_t max_delta, uint16_t alpha)
+{
+    const uint32_t half = (mask + 1) >> 1;
+    const int32_t delta = (int32_t) ((to - from + half) & mask) - (int32_t) half;
+    if (delta > max_delta || delta < -max_delta)
+        return -1;
+    return (from + ((delta * alpha) >> 8)) & mask;
+}
+
 // Palette Address in Memory
 const uint32_t S16_PALETTE_BASE    = 0x120000;
 
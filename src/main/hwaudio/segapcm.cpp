@@ -55,6 +55,7 @@
  */
 
 #include "hwaudio/segapcm.hpp"
+#include "savestate.hpp"
 
 SegaPCM::SegaPCM(uint32_t clock, RomLoader* rom, uint8_t* ram, int32_t bank)
 {
@@ -84,16 +85,39 @@ SegaPCM::~SegaPCM()
     delete[] low;
 }
 
-void SegaPCM::init(int32_t fps)
+void SegaPCM::init(int32_t rate, int32_t fps)
 {
-    int FREQ = 44100;
-    downsample = (32000.0 / (double) FREQ);
-    SoundChip::init(STEREO, FREQ, fps);
+    downsample = (32000.0 / (double) rate);
+    SoundChip::init(STEREO, rate, fps);
 }
 
-void SegaPCM::stream_update()
+// The register RAM belongs to the sound program, which saves it.
+// Only the low address bytes of each channel are internal to the chip.
+void SegaPCM::sync_state(StateBuf& state)
 {
-    SoundChip::clear_buffer();
+    state.sync(low, 16);
+}
+
+uint16_t SegaPCM::active_channels()
+{
+    uint16_t active = 0;
+    for (int ch = 0; ch < 16; ch++)
+    {
+        if ((ram[8 * ch + 0x86] & 1) == 0)
+            active |= 1 << ch;
+    }
+    return active;
+}
+
+void SegaPCM::stream_render(uint32_t offset, uint32_t length)
+{
+    if (silent)
+    {
+        stream_advance(length);
+        return;
+    }
+
+    SoundChip::clear_buffer(offset, length);
 
     // loop over channels
     for (int ch = 0; ch < 16; ch++)
@@ -112,7 +136,7 @@ void SegaPCM::stream_update()
             uint32_t i;
 
             // loop over samples on this channel
-            for (i = 0; i < frame_size; i++) 
+            for (i = offset; i < offset + length; i++) 
             {
                 int8_t v = 0;
 
@@ -138,7 +162,7 @@ void SegaPCM::stream_update()
                 write_buffer(RIGHT, i, read_buffer(RIGHT, i) + (v * regs[3]));
 
                 // Advance.
-                // Cannonball Change: Output at a fixed 44,100Hz. 
+                // Cannonball Change: Output at the configured sample rate.
                 double increment = ((double)regs[7]) * downsample;
                 addr = (addr + (int) increment) & 0xffffff;
             }
@@ -149,4 +173,43 @@ void SegaPCM::stream_update()
             low[ch] = regs[0x86] & 1 ? 0 : addr;
         }
     }
-}
\ No newline at end of file
+}
+
+// Advance the channel addresses by length samples, without fetching or mixing any sample data.
+// Follows the same looping and end of sample handling as stream_render().
+void SegaPCM::stream_advance(uint32_t length)
+{
+    for (int ch = 0; ch < 16; ch++)
+    {
+        uint8_t *regs = ram + 8 * ch;
+
+        if ((regs[0x86] & 1) == 0) 
+        {             
+            uint32_t addr = (regs[0x85] << 16) | (regs[0x84] << 8) | low[ch];
+            uint32_t loop = (regs[0x05] << 16) | (regs[0x04] << 8);
+            uint8_t end   =  regs[0x06] + 1;
+            int increment = (int) (((double)regs[7]) * downsample);
+
+            for (uint32_t i = 0; i < length; i++) 
+            {
+                if ((addr >> 16) == end) 
+                {
+                    if ((regs[0x86] & 2) == 0) 
+                    {
+                        addr = loop;
+                    } 
+                    else 
+                    {
+                        regs[0x86] |= 1;
+                        break;
+                    }
+                }
+                addr = (addr + increment) & 0xffffff;
+            }
+
+            regs[0x84] = addr >> 8;
+            regs[0x85] = addr >> 16;
+            low[ch] = regs[0x86] & 1 ? 0 : addr;
+        }
+    }
+}
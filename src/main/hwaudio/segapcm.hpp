@@ -4,8 +4,8 @@
     This driver is based upon the MAME source code, with some minor 
     modifications to integrate it into the Cannonball framework.
 
-    Note, that I've altered this driver to output at a fixed 44,100Hz.
-    This is to avoid the need for downsampling.  
+    Note, that I've altered this driver to output directly at the
+    configured sample rate. This is to avoid the need for resampling.
     
     See http://mamedev.org/source/docs/license.txt for more details.
 ***************************************************************************/
@@ -16,6 +16,8 @@
 #include "romloader.hpp"
 #include "hwaudio/soundchip.hpp"
 
+class StateBuf;
+
 class SegaPCM : public SoundChip
 {
 public:
@@ -28,8 +30,14 @@ public:
 
     SegaPCM(uint32_t clock, RomLoader* rom, uint8_t* ram, int32_t bank);
     ~SegaPCM();
-    void init(int32_t fps);
-    void stream_update();
+    void init(int32_t rate, int32_t fps);
+    void sync_state(StateBuf& state);
+
+    // Bit per channel currently playing
+    uint16_t active_channels();
+
+protected:
+    void stream_render(uint32_t offset, uint32_t length);
 
 private:
     // PCM Chip Emulation
@@ -42,4 +50,6 @@ private:
     int32_t rgnmask;
 
     double downsample;
+
+    void stream_advance(uint32_t length);
 };
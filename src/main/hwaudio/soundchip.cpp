@@ -4,6 +4,10 @@
     This is an abstract class, used by the Sega PCM and YM2151 chips.
     It facilitates writing to a buffer of sound data.
 
+    A frame can be rendered in slices, so that register writes take
+    effect from the sample they were made at, rather than the start
+    of the frame.
+
     Copyright Chris White.
     See license.txt for more details.
 ***************************************************************************/
@@ -14,6 +18,7 @@
 SoundChip::SoundChip()
 {
     volume     = 1.0;
+    silent     = false;
     initalized = false;
 }
 
@@ -28,13 +33,15 @@ void SoundChip::init(uint8_t channels, int32_t sample_freq, int32_t fps)
     this->sample_freq = sample_freq;
     this->channels    = channels;
 
-    frame_size =  sample_freq / fps;
-    buffer_size = frame_size * channels;
+    frame_size    = sample_freq / fps;
+    buffer_frames = max_frame_size(sample_freq, fps);
+    buffer_size   = buffer_frames * channels;
 
     if (initalized)
         delete[] buffer;
     
     buffer = new int16_t[buffer_size];
+    stream_pos = 0;
 
     initalized = true;
 }
@@ -48,9 +55,27 @@ void SoundChip::set_volume(uint8_t v)
     volume = (float) (v / 10.0);
 }
 
-void SoundChip::clear_buffer()
+void SoundChip::stream_to(uint32_t timestamp)
+{
+    if (timestamp > buffer_frames)
+        timestamp = buffer_frames;
+
+    if (timestamp > stream_pos)
+    {
+        stream_render(stream_pos, timestamp - stream_pos);
+        stream_pos = timestamp;
+    }
+}
+
+void SoundChip::stream_update(uint32_t samples)
+{
+    stream_to(samples);
+    stream_pos = 0;
+}
+
+void SoundChip::clear_buffer(uint32_t offset, uint32_t length)
 {
-    for (uint32_t i = 0; i < buffer_size; i++)
+    for (uint32_t i = offset * channels; i < (offset + length) * channels; i++)
         buffer[i] = 0;
 }
 
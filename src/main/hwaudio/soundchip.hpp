@@ -4,6 +4,10 @@
     This is an abstract class, used by the Sega PCM and YM2151 chips.
     It facilitates writing to a buffer of sound data.
 
+    A frame can be rendered in slices, so that register writes take
+    effect from the sample they were made at, rather than the start
+    of the frame.
+
     Copyright Chris White.
     See license.txt for more details.
 ***************************************************************************/
@@ -24,17 +28,33 @@ public:
     // Size of the buffer (including channel info)
     uint32_t buffer_size;
 
+    // Samples the buffer can hold (excluding channel info)
+    uint32_t buffer_frames;
+
     SoundChip();
     ~SoundChip();
 
     void init(uint8_t, int32_t, int32_t);
 
-    // Pure virtual function. Denotes virtual class.
-    virtual void stream_update() = 0;
+    // Render the current frame up to the given sample
+    void stream_to(uint32_t timestamp);
+
+    // Render the remainder of a frame of the given length and start the next one
+    void stream_update(uint32_t samples);
 
     int16_t* get_buffer();
+
+    // Largest frame that can be rendered. Allows the samples per frame to vary around the nominal rate.
+    static uint32_t max_frame_size(uint32_t sample_freq, uint32_t fps) 
+    { 
+        return (sample_freq / fps) + ((sample_freq / fps) >> 5) + 2;
+    }
     void set_volume(uint8_t);
 
+    // When silent, the chip state is advanced as normal but its output need not be rendered.
+    // Used for frames whose audio will be discarded.
+    void set_silent(bool silent) { this->silent = silent; }
+
 protected:
     const static uint8_t MONO             = 1;
     const static uint8_t STEREO           = 2;
@@ -42,13 +62,20 @@ protected:
     const static uint8_t LEFT             = 0;
     const static uint8_t RIGHT            = 1;
 
-    //  Buffer size for one frame (excluding channel info)
+    //  Nominal buffer size for one frame (excluding channel info)
     uint32_t frame_size;
 
     // Volume of sound chip
     float volume;
 
-    void clear_buffer();
+    // Output not required
+    bool silent;
+
+    // Pure virtual function. Denotes virtual class.
+    // Render length samples, starting at the given sample of the frame.
+    virtual void stream_render(uint32_t offset, uint32_t length) = 0;
+
+    void clear_buffer(uint32_t offset, uint32_t length);
     void write_buffer(const uint8_t, uint32_t, int16_t);
     int16_t read_buffer(const uint8_t, uint32_t);
 
@@ -58,4 +85,7 @@ private:
 
     // Frames per second
     uint32_t fps; 
+
+    // Samples of the current frame rendered so far
+    uint32_t stream_pos;
 };
\ No newline at end of file
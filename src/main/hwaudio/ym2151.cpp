@@ -15,6 +15,7 @@
 #include <cstring>  // For memset on GCC
 
 #include "hwaudio/ym2151.hpp"
+#include "savestate.hpp"
 
 #ifdef __PS3__
 #define memset std::memset
@@ -1280,7 +1281,14 @@ void YM2151::init(int rate, int fps)
 {
     SoundChip::init(STEREO, rate, fps);
     this->sampfreq = rate;
-    init_tables();
+
+    // The tables are shared by every chip, and only built once
+    static bool tables_built = false;
+    if (!tables_built)
+    {
+        init_tables();
+        tables_built = true;
+    }
 
     this->sampfreq = rate ? rate : 44100;    /* avoid division by 0 in init_chip_tables() */
 
@@ -1995,12 +2003,10 @@ void YM2151::advance()
 *   '**buffers' is table of pointers to the buffers: left and right
 *   'length' is the number of samples that should be generated
 */
-void YM2151::stream_update()
+void YM2151::stream_render(uint32_t offset, uint32_t length)
 {
-    SoundChip::clear_buffer();
     uint32_t i;
     int32_t outl,outr;
-    uint32_t length = frame_size;
 
 #ifdef USE_MAME_TIMERS
         /* ASG 980324 - handled by real timers now */
@@ -2022,7 +2028,7 @@ void YM2151::stream_update()
     }
 #endif
 
-    for (i=0; i<length; i++)
+    for (i=offset; i<offset+length; i++)
     {
         advance_eg();
 
@@ -2096,3 +2102,107 @@ void YM2151::stream_update()
         advance();
     }
 }
+
+// ------------------------------------------------------------------------------------------------
+// Save State Support
+// ------------------------------------------------------------------------------------------------
+
+// Operator outputs are routed through pointers to the accumulators above.
+// In a save state, they are stored as an index into this table instead.
+static signed int* const connect_targets[] =
+{
+    NULL,
+    &chanout[0], &chanout[1], &chanout[2], &chanout[3],
+    &chanout[4], &chanout[5], &chanout[6], &chanout[7],
+    &m2, &c1, &c2, &mem
+};
+
+static const uint8_t CONNECT_TARGETS = sizeof(connect_targets) / sizeof(connect_targets[0]);
+
+static uint8_t connect_index(signed int* p)
+{
+    for (uint8_t i = 0; i < CONNECT_TARGETS; i++)
+    {
+        if (connect_targets[i] == p)
+            return i;
+    }
+    return 0;
+}
+
+uint8_t YM2151::active_channels()
+{
+    uint8_t active = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        if (oper[i].state != EG_OFF)
+            active |= 1 << (i >> 2);
+    }
+    return active;
+}
+
+// Values derived from the sample rate (timer and frequency steps) are not saved,
+// so that a state can be restored at a different output rate.
+void YM2151::sync_state(StateBuf& state)
+{
+    state.sync(chanout);
+    state.sync(m2);
+    state.sync(c1);
+    state.sync(c2);
+    state.sync(mem);
+
+    for (int i = 0; i < 32; i++)
+    {
+        YM2151Operator* op = &oper[i];
+        uint8_t connect     = connect_index(op->connects);
+        uint8_t mem_connect = connect_index(op->mem_connect);
+
+        state.sync(*op);
+        state.sync(connect);
+        state.sync(mem_connect);
+
+        if (state.loading())
+        {
+            op->connects    = connect_targets[connect < CONNECT_TARGETS ? connect : 0];
+            op->mem_connect = connect_targets[mem_connect < CONNECT_TARGETS ? mem_connect : 0];
+            op->dt1         = dt1_freq[(op->dt1_i + (op->kc >> 2)) & 0xff];
+            op->freq        = ((freq[(op->kc_i + op->dt2) % (11 * 768)] + op->dt1) * op->mul) >> 1;
+        }
+    }
+
+    state.sync(pan);
+    state.sync(eg_cnt);
+    state.sync(eg_timer);
+    state.sync(lfo_phase);
+    state.sync(lfo_timer);
+    state.sync(lfo_overflow);
+    state.sync(lfo_counter);
+    state.sync(lfo_counter_add);
+    state.sync(lfo_wsel);
+    state.sync(amd);
+    state.sync(pmd);
+    state.sync(lfa);
+    state.sync(lfp);
+    state.sync(test);
+    state.sync(ct);
+    state.sync(noise);
+    state.sync(noise_rng);
+    state.sync(noise_p);
+    state.sync(csm_req);
+    state.sync(irq_enable);
+    state.sync(status);
+    state.sync(connects);
+#ifndef USE_MAME_TIMERS
+    state.sync(tim_A);
+    state.sync(tim_B);
+    state.sync(tim_A_val);
+    state.sync(tim_B_val);
+#endif
+    state.sync(timer_A_index);
+    state.sync(timer_B_index);
+    state.sync(timer_A_index_old);
+    state.sync(timer_B_index_old);
+    state.sync(irq);
+
+    if (state.loading())
+        noise_f = noise_tab[noise & 0x1f];
+}
@@ -16,6 +16,8 @@
 #include "romloader.hpp"
 #include "hwaudio/soundchip.hpp"
 
+class StateBuf;
+
 /* struct describing a single operator */
 typedef struct
 {
@@ -77,9 +79,15 @@ public:
     YM2151(float volume, uint32_t clock);
     ~YM2151();
     void init(int rate, int fps);
-    void stream_update();
     void write_reg(int r, int v);
     int read_status();
+    void sync_state(StateBuf& state);
+
+    // Bit per channel with an operator still sounding
+    uint8_t active_channels();
+
+protected:
+    void stream_render(uint32_t offset, uint32_t length);
 
 private:
     int clock;        /*chip clock in Hz (passed from 2151intf.c)*/
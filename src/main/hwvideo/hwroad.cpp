@@ -2,6 +2,7 @@
 #include "hwvideo/hwroad.hpp"
 #include "globals.hpp"
 #include "frontend/config.hpp"
+#include "savestate.hpp"
 
 /***************************************************************************
     Video Emulation: OutRun Road Rendering Hardware.
@@ -106,7 +107,9 @@
  *
  *******************************************************************************************/
 
-HWRoad hwroad;
+ENGINE_GLOBAL HWRoad hwroad;
+
+uint8_t HWRoad::roads[0x40200];
 
 HWRoad::HWRoad()
 {
@@ -120,6 +123,7 @@ HWRoad::~HWRoad()
 void HWRoad::init(const uint8_t* src_road, const bool hires)
 {
     road_control = 0;
+    blended = false;
     color_offset1 = 0x400;
     color_offset2 = 0x420;
     color_offset3 = 0x780;
@@ -209,6 +213,16 @@ void HWRoad::write32(uint32_t* adr, const uint32_t data)
     *adr += 4;
 }
 
+// Write a run of words, as the same number of calls to write16 would
+void HWRoad::write_block16(uint32_t adr, const uint16_t* data, const uint16_t count)
+{
+    const uint16_t index = (adr >> 1) & 0x7FF;
+    const uint16_t first = count < 0x800 - index ? count : 0x800 - index;
+
+    memcpy(ram + index, data, first * sizeof(uint16_t));
+    memcpy(ram, data + first, (count - first) * sizeof(uint16_t));
+}
+
 uint16_t HWRoad::read_road_control()
 {
     uint32_t *src = (uint32_t *)ram;
@@ -230,6 +244,73 @@ void HWRoad::write_road_control(const uint8_t road_control)
     this->road_control = road_control;
 }
 
+// Decoded road graphics are derived from ROM, so only RAM and registers are saved
+void HWRoad::sync_state(StateBuf& state)
+{
+    state.sync(ram);
+    state.sync(ramBuff);
+    state.sync(ramPrev);
+    state.sync(road_control);
+    state.sync(color_offset1);
+    state.sync(color_offset2);
+    state.sync(color_offset3);
+    state.sync(x_offset);
+}
+
+void HWRoad::hash_state(StateHash& hash)
+{
+    hash.add_words(ram, ROAD_RAM_SIZE / 2);
+    hash.add_words(ramBuff, ROAD_RAM_SIZE / 2);
+    hash.add8(road_control);
+    hash.add16(color_offset1);
+    hash.add16(color_offset2);
+    hash.add16(color_offset3);
+    hash.add32(x_offset);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Interpolated Frames
+// ------------------------------------------------------------------------------------------------
+
+// Keep the frame on display, to blend from. Call before the engine updates the road.
+void HWRoad::save_frame()
+{
+    memcpy(ramPrev, ramBuff, sizeof(ramBuff));
+}
+
+// Blend the road of the previous frame with the current one, for drawing.
+// The line each scanline shows (hills) and the horizontal scroll of each line (curves and steering)
+// are blended. Colours, and lines that jump or change type, are taken from the current frame.
+void HWRoad::blend_frame(const uint16_t alpha)
+{
+    blended = alpha < BLEND_ONE;
+    if (!blended)
+        return;
+
+    memcpy(ramBlend, ramBuff, sizeof(ramBuff));
+
+    // Line selection for each scanline of both roads. Solid fill lines are left alone.
+    for (int i = 0x000; i < 0x200; i++)
+    {
+        const uint16_t from = ramPrev[i];
+        const uint16_t to   = ramBuff[i];
+        if (((from | to) & 0x800) || (from & ~0x1ff) != (to & ~0x1ff))
+            continue;
+
+        const int32_t line = blend_wrap(from & 0x1ff, to & 0x1ff, 0x1ff, 0x20, alpha);
+        if (line >= 0)
+            ramBlend[i] = (to & ~0x1ff) | line;
+    }
+
+    // Horizontal scroll of each line of both roads
+    for (int i = 0x200; i < 0x600; i++)
+    {
+        const int32_t hpos = blend_wrap(ramPrev[i] & 0xfff, ramBuff[i] & 0xfff, 0xfff, 0x100, alpha);
+        if (hpos >= 0)
+            ramBlend[i] = (ramBuff[i] & ~0xfff) | hpos;
+    }
+}
+
 // ------------------------------------------------------------------------------------------------
 // Road Rendering: Lores Version
 // ------------------------------------------------------------------------------------------------
@@ -238,7 +319,7 @@ void HWRoad::write_road_control(const uint8_t road_control)
 void HWRoad::render_background_lores(uint16_t* pixels)
 {
     int x, y;
-    uint16_t* roadram = ramBuff;
+    uint16_t* roadram = blended ? ramBlend : ramBuff;
 
     for (y = 0; y < S16_HEIGHT; y++) 
     {
@@ -291,7 +372,7 @@ void HWRoad::render_background_lores(uint16_t* pixels)
 void HWRoad::render_foreground_lores(uint16_t* pixels)
 {
     int x, y;
-    uint16_t* roadram = ramBuff;
+    uint16_t* roadram = blended ? ramBlend : ramBuff;
     
     for (y = 0; y < S16_HEIGHT; y++) 
     {
@@ -416,7 +497,7 @@ void HWRoad::render_foreground_lores(uint16_t* pixels)
 void HWRoad::render_background_hires(uint16_t* pixels)
 {
     int x, y;
-    uint16_t* roadram = ramBuff;
+    uint16_t* roadram = blended ? ramBlend : ramBuff;
 
     for (y = 0; y < config.s16_height; y += 2) 
     {
@@ -475,7 +556,7 @@ void HWRoad::render_background_hires(uint16_t* pixels)
 void HWRoad::render_foreground_hires(uint16_t* pixels)
 {
     int x, y, yy;
-    uint16_t* roadram = ramBuff;
+    uint16_t* roadram = blended ? ramBlend : ramBuff;
     
     uint16_t color_table[32];
     int32_t color0, color1;
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <stdint.h>
+#include "globals.hpp"
+
+class StateBuf;
+class StateHash;
 
 class HWRoad
 {
@@ -12,8 +16,13 @@ public:
     void write16(uint32_t adr, const uint16_t data);
     void write16(uint32_t* adr, const uint16_t data);
     void write32(uint32_t* adr, const uint32_t data);
+    void write_block16(uint32_t adr, const uint16_t* data, const uint16_t count);
     uint16_t read_road_control();
     void write_road_control(const uint8_t);
+    void sync_state(StateBuf& state);
+    void hash_state(StateHash& hash);
+    void save_frame();
+    void blend_frame(const uint16_t alpha);
     void (HWRoad::*render_background)(uint16_t*);
     void (HWRoad::*render_foreground)(uint16_t*);
   
@@ -27,13 +36,18 @@ private:
     static const uint16_t ROAD_RAM_SIZE = 0x1000;
     static const uint16_t rom_size = 0x8000;
 
-    // Decoded road graphics
-    uint8_t roads[0x40200];
+    // Decoded road graphics. Read-only once decoded, so shared by every engine context.
+    static uint8_t roads[0x40200];
 
     // Two halves of RAM
     uint16_t ram[ROAD_RAM_SIZE / 2];
     uint16_t ramBuff[ROAD_RAM_SIZE / 2];
 
+    // Interpolated frames: The RAM buffer of the previous frame, and the blend of the two drawn instead
+    uint16_t ramPrev[ROAD_RAM_SIZE / 2];
+    uint16_t ramBlend[ROAD_RAM_SIZE / 2];
+    bool blended;
+
     void decode_road(const uint8_t*);
     void render_background_lores(uint16_t*);
     void render_foreground_lores(uint16_t*);
@@ -41,4 +55,4 @@ private:
     void render_foreground_hires(uint16_t*);
 };
 
-extern HWRoad hwroad;
+extern ENGINE_GLOBAL HWRoad hwroad;
@@ -2,6 +2,7 @@
 #include "hwvideo/hwsprites.hpp"
 #include "globals.hpp"
 #include "frontend/config.hpp"
+#include "savestate.hpp"
 
 /***************************************************************************
     Video Emulation: OutRun Sprite Rendering Hardware.
@@ -48,8 +49,11 @@
 *
  *******************************************************************************************/
 
+uint32_t hwsprites::sprites[SPRITES_LENGTH];
+
 hwsprites::hwsprites()
 {
+    blended = false;
 }
 
 hwsprites::~hwsprites()
@@ -139,6 +143,78 @@ void hwsprites::swap()
     }
 }
 
+void hwsprites::sync_state(StateBuf& state)
+{
+    state.sync(ram);
+    state.sync(ramBuff);
+    state.sync(ramPrev);
+}
+
+void hwsprites::hash_state(StateHash& hash)
+{
+    hash.add_words(ram, SPRITE_RAM_SIZE);
+    hash.add_words(ramBuff, SPRITE_RAM_SIZE);
+}
+
+// Keep the sprite list on display, to blend from. Call before the engine updates the sprites.
+void hwsprites::save_frame()
+{
+    memcpy(ramPrev, ramBuff, sizeof(ramBuff));
+}
+
+// Blend the sprite list of the previous frame with the current one, for drawing.
+//
+// The hardware list holds no identity for each sprite, so a sprite is only blended with the
+// entry in the same slot last frame when it looks like the same object: The same palette and
+// orientation, and not far away. The zoom is only blended when the graphic is also the same.
+void hwsprites::blend_frame(const uint16_t alpha)
+{
+    blended = alpha < BLEND_ONE;
+    if (!blended)
+        return;
+
+    memcpy(ramBlend, ramBuff, sizeof(ramBuff));
+
+    for (uint16_t data = 0; data < SPRITE_RAM_SIZE; data += 8)
+    {
+        const uint16_t* from = ramPrev + data;
+        const uint16_t* to   = ramBuff + data;
+        uint16_t* out        = ramBlend + data;
+
+        // End of either list
+        if ((from[0] | to[0]) & 0x8000)
+            break;
+
+        // Hidden, another bank, palette or orientation
+        if ((from[0] & 0xfe00) != (to[0] & 0xfe00) || (to[0] & 0x5000) ||
+            (from[5] & 0x7f) != (to[5] & 0x7f) ||
+            (from[4] & 0xe000) != (to[4] & 0xe000))
+            continue;
+
+        const int32_t top  = blend_wrap(from[0] & 0x1ff, to[0] & 0x1ff, 0x1ff, 0x40, alpha);
+        const int32_t xpos = blend_wrap(from[6], to[6], 0xffff, 0x40, alpha);
+        if (top < 0 || xpos < 0)
+            continue;
+
+        out[0] = (to[0] & ~0x1ff) | top;
+        out[6] = xpos;
+
+        // Same graphic: Blend the zoom and height
+        if (from[1] == to[1] && from[2] == to[2])
+        {
+            const int32_t vzoom  = blend_wrap(from[3] & 0x7ff, to[3] & 0x7ff, 0x7ff, 0x100, alpha);
+            const int32_t hzoom  = blend_wrap(from[4] & 0x7ff, to[4] & 0x7ff, 0x7ff, 0x100, alpha);
+            const int32_t height = blend_wrap(from[5] >> 8, to[5] >> 8, 0xff, 0x40, alpha);
+            if (vzoom >= 0 && hzoom >= 0 && height >= 0)
+            {
+                out[3] = (to[3] & ~0x7ff) | vzoom;
+                out[4] = (to[4] & ~0x7ff) | hzoom;
+                out[5] = (to[5] & 0xff) | (height << 8);
+            }
+        }
+    }
+}
+
 #define draw_pixel()                                                                                  \
 {                                                                                                     \
     if (x >= x1 && x < x2 && pix != 0 && pix != 15)                                                   \
@@ -158,32 +234,33 @@ void hwsprites::swap()
 void hwsprites::render(const uint8_t priority)
 {
     const uint32_t numbanks = SPRITES_LENGTH / 0x10000;
+    uint16_t* list = blended ? ramBlend : ramBuff;
 
     for (uint16_t data = 0; data < SPRITE_RAM_SIZE; data += 8) 
     {
         // stop when we hit the end of sprite list
-        if ((ramBuff[data+0] & 0x8000) != 0) break;
+        if ((list[data+0] & 0x8000) != 0) break;
 
-        uint32_t sprpri  = 1 << ((ramBuff[data+3] >> 12) & 3);
+        uint32_t sprpri  = 1 << ((list[data+3] >> 12) & 3);
         if (sprpri != priority) continue;
 
         // if hidden, or top greater than/equal to bottom, or invalid bank, punt
-        int16_t hide    = (ramBuff[data+0] & 0x5000);
-        int32_t height  = (ramBuff[data+5] >> 8) + 1;       
+        int16_t hide    = (list[data+0] & 0x5000);
+        int32_t height  = (list[data+5] >> 8) + 1;       
         if (hide != 0 || height == 0) continue;
         
-        int16_t bank    = (ramBuff[data+0] >> 9) & 7;
-        int32_t top     = (ramBuff[data+0] & 0x1ff) - 0x100;
-        uint32_t addr    = ramBuff[data+1];
-        int32_t pitch  = ((ramBuff[data+2] >> 1) | ((ramBuff[data+4] & 0x1000) << 3)) >> 8;
-        int32_t xpos    =  ramBuff[data+6]; // moved from original structure to accomodate widescreen
-        uint8_t shadow  = (ramBuff[data+3] >> 14) & 1;
-        int32_t vzoom    = ramBuff[data+3] & 0x7ff;
-        int32_t ydelta = ((ramBuff[data+4] & 0x8000) != 0) ? 1 : -1;
-        int32_t flip   = (~ramBuff[data+4] >> 14) & 1;
-        int32_t xdelta = ((ramBuff[data+4] & 0x2000) != 0) ? 1 : -1;
-        int32_t hzoom    = ramBuff[data+4] & 0x7ff;     
-        int32_t color   = COLOR_BASE + ((ramBuff[data+5] & 0x7f) << 4);
+        int16_t bank    = (list[data+0] >> 9) & 7;
+        int32_t top     = (list[data+0] & 0x1ff) - 0x100;
+        uint32_t addr    = list[data+1];
+        int32_t pitch  = ((list[data+2] >> 1) | ((list[data+4] & 0x1000) << 3)) >> 8;
+        int32_t xpos    =  list[data+6]; // moved from original structure to accomodate widescreen
+        uint8_t shadow  = (list[data+3] >> 14) & 1;
+        int32_t vzoom    = list[data+3] & 0x7ff;
+        int32_t ydelta = ((list[data+4] & 0x8000) != 0) ? 1 : -1;
+        int32_t flip   = (~list[data+4] >> 14) & 1;
+        int32_t xdelta = ((list[data+4] & 0x2000) != 0) ? 1 : -1;
+        int32_t hzoom    = list[data+4] & 0x7ff;     
+        int32_t color   = COLOR_BASE + ((list[data+5] & 0x7f) << 4);
         int32_t x, y, ytarget, yacc = 0, pix;
             
         // adjust X coordinate
@@ -194,7 +271,7 @@ void hwsprites::render(const uint8_t priority)
         xpos -= 0xbe;
 
         // initialize the end address to the start address
-        ramBuff[data+7] = addr;
+        list[data+7] = addr;
 
         // clamp to within the memory region size
         if (numbanks)
@@ -234,11 +311,11 @@ void hwsprites::render(const uint8_t priority)
                 if (flip == 0)
                 {
                     // start at the word before because we preincrement below
-                    ramBuff[data+7] = (addr - 1);
+                    list[data+7] = (addr - 1);
 
                     for (x = xpos; (xdelta > 0 && x < config.s16_width) || (xdelta < 0 && x >= 0); )
                     {
-                        uint32_t pixels = spritedata[++ramBuff[data+7]]; // Add to base sprite data the vzoom value
+                        uint32_t pixels = spritedata[++list[data+7]]; // Add to base sprite data the vzoom value
 
                         // draw four pixels
                         pix = (pixels >> 28) & 0xf; while (xacc < 0x200) { draw_pixel(); x += xdelta; xacc += hzoom; } xacc -= 0x200;
@@ -259,11 +336,11 @@ void hwsprites::render(const uint8_t priority)
                 else
                 {
                     // start at the word after because we predecrement below
-                    ramBuff[data+7] = (addr + 1);
+                    list[data+7] = (addr + 1);
 
                     for (x = xpos; (xdelta > 0 && x < config.s16_width) || (xdelta < 0 && x >= 0); )
                     {
-                        uint32_t pixels = spritedata[--ramBuff[data+7]];
+                        uint32_t pixels = spritedata[--list[data+7]];
 
                         // draw four pixels
                         pix = (pixels >>  0) & 0xf; while (xacc < 0x200) { draw_pixel(); x += xdelta; xacc += hzoom; } xacc -= 0x200;
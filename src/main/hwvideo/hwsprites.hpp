@@ -3,6 +3,8 @@
 #include <stdint.h>
 
 class video;
+class StateBuf;
+class StateHash;
 
 class hwsprites
 {
@@ -16,6 +18,10 @@ public:
     uint8_t read(const uint16_t adr);
     void write(const uint16_t adr, const uint16_t data);
     void render(const uint8_t);
+    void sync_state(StateBuf& state);
+    void hash_state(StateHash& hash);
+    void save_frame();
+    void blend_frame(const uint16_t alpha);
 
 private:
     // Clip values.
@@ -26,10 +32,15 @@ private:
     static const uint32_t SPRITES_LENGTH = 0x100000 >> 2;
     static const uint16_t COLOR_BASE = 0x800;
 
-    uint32_t sprites[SPRITES_LENGTH]; // Converted sprites
+    static uint32_t sprites[SPRITES_LENGTH]; // Converted sprites, shared by every engine context
     
     // Two halves of RAM
     uint16_t ram[SPRITE_RAM_SIZE];
     uint16_t ramBuff[SPRITE_RAM_SIZE];
+
+    // Interpolated frames: The sprite list of the previous frame, and the blend of the two drawn instead
+    uint16_t ramPrev[SPRITE_RAM_SIZE];
+    uint16_t ramBlend[SPRITE_RAM_SIZE];
+    bool blended;
 };
 
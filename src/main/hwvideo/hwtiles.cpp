@@ -3,6 +3,7 @@
 #include "romloader.hpp"
 #include "hwvideo/hwtiles.hpp"
 #include "frontend/config.hpp"
+#include "savestate.hpp"
 #include <cstring>
 
 /***************************************************************************
@@ -76,6 +77,9 @@
  *
  *******************************************************************************************/
 
+uint32_t hwtiles::tiles[TILES_LENGTH];
+uint32_t hwtiles::tiles_backup[TILES_LENGTH];
+
 hwtiles::hwtiles(void)
 {
     for (int i = 0; i < 2; i++)
@@ -186,6 +190,43 @@ void hwtiles::update_tile_values()
     }
 }
 
+// Keep the scroll values on display, to blend from. Call before the engine updates the tilemaps.
+void hwtiles::save_frame()
+{
+    update_tile_values();
+    memcpy(page_prev, page, sizeof(page));
+    memcpy(scroll_x_prev, scroll_x, sizeof(scroll_x));
+    memcpy(scroll_y_prev, scroll_y, sizeof(scroll_y));
+}
+
+// Blend the scroll values of the previous frame with the current ones. Call after update_tile_values().
+// Tilemaps that change page, or use per-row scrolling, are taken from the current frame.
+void hwtiles::blend_frame(const uint16_t alpha)
+{
+    if (alpha >= BLEND_ONE)
+        return;
+
+    for (int i = 0; i < 4; i++)
+    {
+        if (page[i] != page_prev[i] || ((scroll_x[i] | scroll_x_prev[i] | scroll_y[i] | scroll_y_prev[i]) & 0x8000))
+            continue;
+
+        const int32_t x = blend_wrap(scroll_x_prev[i] & 0x3ff, scroll_x[i] & 0x3ff, 0x3ff, 0x80, alpha);
+        const int32_t y = blend_wrap(scroll_y_prev[i] & 0x1ff, scroll_y[i] & 0x1ff, 0x1ff, 0x80, alpha);
+        if (x >= 0) scroll_x[i] = (scroll_x[i] & ~0x3ff) | x;
+        if (y >= 0) scroll_y[i] = (scroll_y[i] & ~0x1ff) | y;
+    }
+}
+
+void hwtiles::sync_state(StateBuf& state)
+{
+    state.sync(text_ram);
+    state.sync(tile_ram);
+    state.sync(page_prev);
+    state.sync(scroll_x_prev);
+    state.sync(scroll_y_prev);
+}
+
 // A quick and dirty debug function to display the contents of tile memory.
 void hwtiles::render_all_tiles(uint16_t* buf)
 {
@@ -3,6 +3,7 @@
 #include <stdint.h>
 
 class RomLoader;
+class StateBuf;
 
 class hwtiles
 {
@@ -25,6 +26,9 @@ public:
     void restore_tiles();
     void set_x_clamp(const uint16_t);
     void update_tile_values();
+    void save_frame();
+    void blend_frame(const uint16_t alpha);
+    void sync_state(StateBuf& state);
     void render_tile_layer(uint16_t*, uint8_t, uint8_t);
     void render_text_layer(uint16_t*, uint8_t);
     void render_all_tiles(uint16_t*);
@@ -36,13 +40,19 @@ private:
     uint16_t s16_width_noscale;
 
     static const int TILES_LENGTH = 0x10000;
-    uint32_t tiles[TILES_LENGTH];        // Converted tiles
-    uint32_t tiles_backup[TILES_LENGTH]; // Converted tiles (backup without patch)
+    // Shared by every engine context
+    static uint32_t tiles[TILES_LENGTH];        // Converted tiles
+    static uint32_t tiles_backup[TILES_LENGTH]; // Converted tiles (backup without patch)
 
     uint16_t page[4];
     uint16_t scroll_x[4];
     uint16_t scroll_y[4];
 
+    // Interpolated frames: Scroll values of the previous frame
+    uint16_t page_prev[4];
+    uint16_t scroll_x_prev[4];
+    uint16_t scroll_y_prev[4];
+
     uint8_t tile_banks[2];
 
     static const uint16_t NUM_TILES = 0x2000; // Length of graphic rom / 24
@@ -0,0 +1,447 @@
+/***************************************************************************
+    Input Log.
+
+    Records the player's input each engine tick, so a session can be
+    played back exactly. Used for bug reports, performance regression
+    runs and attract mode content.
+
+    The log starts with a header holding the settings that affect the
+    engine, a checksum of the program ROMs and the random seeds. This is
+    followed by one entry per change in the controls, holding the number
+    of ticks the previous controls were held for.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <string.h>
+#include <stdlib.h>
+#include <time.h>
+#include <boost/crc.hpp>
+
+#include <libretro.h>
+#include <streams/file_stream.h>
+
+#include "main.hpp"
+#include "roms.hpp"
+#include "inputlog.hpp"
+#include "libretro/input.hpp"
+#include "engine/outils.hpp"
+#include "engine/outrun.hpp"
+#include "frontend/config.hpp"
+#include "savestate.hpp"
+
+extern retro_log_printf_t log_cb;
+
+ENGINE_GLOBAL InputLog inputlog;
+
+static const uint8_t MAGIC[4] = { 'C', 'B', 'I', 'L' };
+
+// Bump when the layout of the log changes
+static const uint32_t VERSION = 3;
+
+// Header: Magic, Version, ROM CRC, Seed, Entropy, Setting Count, Settings
+static const uint32_t HEADER_WORDS = 5 + 1;
+
+// Entry: [Ticks Held: Varint] [Changed Fields: Byte] [Each Changed Field: Varint]
+enum
+{
+    FIELD_KEYS  = 1 << 0,
+    FIELD_WHEEL = 1 << 1,
+    FIELD_ACCEL = 1 << 2,
+    FIELD_BRAKE = 1 << 3,
+};
+
+static void put_varint(std::vector<uint8_t>& out, uint32_t v)
+{
+    while (v >= 0x80)
+    {
+        out.push_back((uint8_t) (v | 0x80));
+        v >>= 7;
+    }
+    out.push_back((uint8_t) v);
+}
+
+static bool get_varint(const std::vector<uint8_t>& in, uint32_t* pos, uint32_t* v)
+{
+    *v = 0;
+    for (uint32_t shift = 0; *pos < in.size() && shift < 32; shift += 7)
+    {
+        const uint8_t b = in[(*pos)++];
+        *v |= (b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            return true;
+    }
+    return false;
+}
+
+static void put_word(std::vector<uint8_t>& out, uint32_t v)
+{
+    out.push_back(v & 0xFF);
+    out.push_back((v >> 8) & 0xFF);
+    out.push_back((v >> 16) & 0xFF);
+    out.push_back(v >> 24);
+}
+
+static uint32_t get_word(const std::vector<uint8_t>& in, uint32_t pos)
+{
+    return in[pos] | (in[pos + 1] << 8) | (in[pos + 2] << 16) | (in[pos + 3] << 24);
+}
+
+template<typename T> static inline void sync_setting(int32_t* values, int& n, T& v, bool apply)
+{
+    if (apply)
+        v = (T) values[n];
+    else
+        values[n] = (int32_t) v;
+    n++;
+}
+
+InputLog::InputLog()
+{
+    mode       = MODE_OFF;
+    active     = false;
+    first_tick = false;
+    session    = (uint32_t) time(NULL);
+    rom_crc    = 0;
+    seed       = 0;
+    entropy    = 0;
+    pos        = 0;
+    run        = 0;
+    memset(settings, 0, sizeof(settings));
+    memset(user_settings, 0, sizeof(user_settings));
+    memset(&controls, 0, sizeof(controls));
+    memset(&base, 0, sizeof(base));
+}
+
+InputLog::~InputLog()
+{
+}
+
+void InputLog::set_mode(int mode, const char* filename)
+{
+    if (mode != this->mode || this->filename != filename)
+        stop();
+
+    this->mode     = mode;
+    this->filename = filename;
+}
+
+// Settings that change the behaviour of the engine, or how the controls are read.
+// The frame rate is stored but never applied, as it can't change while running.
+void InputLog::sync_settings(int32_t* values, bool apply)
+{
+    int n = 0;
+
+    sync_setting(values, n, outrun.cannonball_mode, apply);
+    sync_setting(values, n, outrun.ttrial.enabled, apply);
+    sync_setting(values, n, outrun.ttrial.level, apply);
+    sync_setting(values, n, outrun.ttrial.traffic, apply);
+    sync_setting(values, n, outrun.ttrial.laps, apply);
+    sync_setting(values, n, config.cont_traffic, apply);
+
+    sync_setting(values, n, config.engine.dip_time, apply);
+    sync_setting(values, n, config.engine.dip_traffic, apply);
+    sync_setting(values, n, config.engine.freeplay, apply);
+    sync_setting(values, n, config.engine.freeze_timer, apply);
+    sync_setting(values, n, config.engine.disable_traffic, apply);
+    sync_setting(values, n, config.engine.jap, apply);
+    sync_setting(values, n, config.engine.prototype, apply);
+    sync_setting(values, n, config.engine.randomgen, apply);
+    sync_setting(values, n, config.engine.level_objects, apply);
+    sync_setting(values, n, config.engine.fix_bugs, apply);
+    sync_setting(values, n, config.engine.fix_timer, apply);
+    sync_setting(values, n, config.engine.sprite_limits, apply);
+    sync_setting(values, n, config.engine.layout_debug, apply);
+    sync_setting(values, n, config.engine.new_attract, apply);
+
+    sync_setting(values, n, config.controls.gear, apply);
+    sync_setting(values, n, config.controls.steer_speed, apply);
+    sync_setting(values, n, config.controls.pedal_speed, apply);
+    sync_setting(values, n, input.analog, apply);
+
+    if (!apply)
+        values[n] = config.fps;
+    n++;
+}
+
+void InputLog::start()
+{
+    stop();
+
+    if (mode == MODE_OFF || filename.empty())
+        return;
+
+    if (mode == MODE_RECORD)
+    {
+        sync_settings(settings, false);
+        data.clear();
+        memset(&controls, 0, sizeof(controls));
+        memset(&base, 0, sizeof(base));
+        run = 0;
+    }
+    else
+    {
+        if (!load())
+            return;
+
+        if (settings[SETTINGS - 1] != config.fps && log_cb)
+            log_cb(RETRO_LOG_WARN, "Input log recorded at %d fps. Playback may differ.\n", settings[SETTINGS - 1]);
+
+        sync_settings(user_settings, false);
+        sync_settings(settings, true);
+        memset(&controls, 0, sizeof(controls));
+        memset(&base, 0, sizeof(base));
+        run = 0;
+    }
+
+    active     = true;
+    first_tick = true;
+    session++;
+}
+
+void InputLog::stop()
+{
+    if (!active)
+        return;
+
+    if (mode == MODE_RECORD)
+    {
+        if (run)
+            put_entry(controls, run);
+        save();
+    }
+    else
+    {
+        sync_settings(user_settings, true);
+    }
+
+    active = false;
+    data.clear();
+}
+
+// Save or restore the position in the log.
+//
+// The frontend loads states for run-ahead, netplay rollback and rewind, as well as user loads. 
+// The log moves back with the engine: A recording is cut back to the length it had when the
+// state was saved, and playback resumes from the entry it had reached.
+// A state saved outside the current log can't be followed, so the log is ended.
+void InputLog::sync_state(StateBuf& state)
+{
+    uint8_t saved_active       = active;
+    uint8_t saved_first_tick   = first_tick;
+    uint32_t saved_session     = session;
+    uint32_t saved_length      = (uint32_t) data.size();
+    uint32_t saved_pos         = pos;
+    uint32_t saved_run         = run;
+    controls_t saved_controls  = controls;
+    controls_t saved_base      = base;
+
+    state.sync(saved_active);
+    state.sync(saved_first_tick);
+    state.sync(saved_session);
+    state.sync(saved_length);
+    state.sync(saved_pos);
+    state.sync(saved_run);
+    state.sync(saved_controls);
+    state.sync(saved_base);
+
+    if (!state.loading() || !active)
+        return;
+
+    if (!saved_active || saved_session != session || saved_length > data.size() || saved_pos > data.size())
+    {
+        if (log_cb)
+            log_cb(RETRO_LOG_WARN, "Loaded state is not part of the current input log. The log has been ended.\n");
+        stop();
+        return;
+    }
+
+    if (mode == MODE_RECORD)
+        data.resize(saved_length);
+
+    first_tick = saved_first_tick != 0;
+    pos        = saved_pos;
+    run        = saved_run;
+    controls   = saved_controls;
+    base       = saved_base;
+}
+
+void InputLog::tick()
+{
+    if (!active)
+        return;
+
+    // The engine has been initialised by now, so the seed and ROM paging are known
+    if (first_tick)
+    {
+        first_tick = false;
+
+        if (mode == MODE_RECORD)
+        {
+            rom_crc = calc_rom_crc();
+            seed    = outils::get_random_seed();
+            entropy = outils::get_entropy();
+        }
+        else
+        {
+            if (rom_crc != calc_rom_crc())
+            {
+                if (log_cb)
+                    log_cb(RETRO_LOG_ERROR, "Input log was recorded with different ROMs.\n");
+                stop();
+                return;
+            }
+            outils::set_random_seed(seed);
+            outils::set_entropy(entropy);
+        }
+    }
+
+    if (mode == MODE_RECORD)
+        read_controls();
+    else
+        write_controls();
+}
+
+// Checksum of the program ROMs in use
+uint32_t InputLog::calc_rom_crc()
+{
+    boost::crc_32_type result;
+    result.process_bytes(roms.rom0p->rom, roms.rom0p->length);
+    result.process_bytes(roms.rom1p->rom, roms.rom1p->length);
+    return result.checksum();
+}
+
+// Record this tick's controls, extending the current run when unchanged
+void InputLog::read_controls()
+{
+    controls_t next;
+    next.keys = 0;
+    for (uint32_t i = 0; i < sizeof(input.keys); i++)
+        next.keys |= (input.keys[i] ? 1 : 0) << i;
+    next.wheel = input.a_wheel;
+    next.accel = input.a_accel;
+    next.brake = input.a_brake;
+
+    if (run && memcmp(&next, &controls, sizeof(controls)) == 0)
+    {
+        run++;
+        return;
+    }
+
+    if (run)
+        put_entry(controls, run);
+
+    controls = next;
+    run      = 1;
+}
+
+// Replace this tick's controls with those from the log
+void InputLog::write_controls()
+{
+    if (run == 0 && !get_entry())
+    {
+        // End of log: Return control to the player
+        stop();
+        return;
+    }
+
+    for (uint32_t i = 0; i < sizeof(input.keys); i++)
+        input.keys[i] = (controls.keys >> i) & 1;
+    input.a_wheel = controls.wheel;
+    input.a_accel = controls.accel;
+    input.a_brake = controls.brake;
+    run--;
+}
+
+void InputLog::put_entry(const controls_t& next, uint32_t ticks)
+{
+    uint8_t changed = 0;
+    if (next.keys  != base.keys)  changed |= FIELD_KEYS;
+    if (next.wheel != base.wheel) changed |= FIELD_WHEEL;
+    if (next.accel != base.accel) changed |= FIELD_ACCEL;
+    if (next.brake != base.brake) changed |= FIELD_BRAKE;
+
+    put_varint(data, ticks);
+    data.push_back(changed);
+    if (changed & FIELD_KEYS)  put_varint(data, next.keys);
+    if (changed & FIELD_WHEEL) put_varint(data, next.wheel);
+    if (changed & FIELD_ACCEL) put_varint(data, next.accel);
+    if (changed & FIELD_BRAKE) put_varint(data, next.brake);
+
+    base = next;
+}
+
+bool InputLog::get_entry()
+{
+    uint32_t ticks = 0;
+    if (!get_varint(data, &pos, &ticks) || pos >= data.size())
+        return false;
+
+    const uint8_t changed = data[pos++];
+    bool ok = true;
+    if (changed & FIELD_KEYS)  ok &= get_varint(data, &pos, &controls.keys);
+    if (changed & FIELD_WHEEL) ok &= get_varint(data, &pos, &controls.wheel);
+    if (changed & FIELD_ACCEL) ok &= get_varint(data, &pos, &controls.accel);
+    if (changed & FIELD_BRAKE) ok &= get_varint(data, &pos, &controls.brake);
+
+    run = ticks;
+    return ok && ticks > 0;
+}
+
+bool InputLog::load()
+{
+    void* buf   = NULL;
+    int64_t len = 0;
+
+    if (!filestream_read_file(filename.c_str(), &buf, &len))
+    {
+        if (log_cb)
+            log_cb(RETRO_LOG_ERROR, "Cannot open input log: %s\n", filename.c_str());
+        return false;
+    }
+
+    data.assign((uint8_t*) buf, (uint8_t*) buf + len);
+    free(buf);
+
+    const uint32_t header_size = (HEADER_WORDS + SETTINGS) * 4;
+
+    if (data.size() < header_size ||
+        memcmp(&data[0], MAGIC, sizeof(MAGIC)) != 0 ||
+        get_word(data, 4)  != VERSION ||
+        get_word(data, 20) != SETTINGS)
+    {
+        if (log_cb)
+            log_cb(RETRO_LOG_ERROR, "Invalid input log: %s\n", filename.c_str());
+        data.clear();
+        return false;
+    }
+
+    rom_crc = get_word(data, 8);
+    seed    = get_word(data, 12);
+    entropy = get_word(data, 16);
+    for (int i = 0; i < SETTINGS; i++)
+        settings[i] = (int32_t) get_word(data, 24 + (i * 4));
+
+    pos = header_size;
+    return true;
+}
+
+void InputLog::save()
+{
+    std::vector<uint8_t> out;
+    out.reserve((HEADER_WORDS + SETTINGS) * 4 + data.size());
+
+    out.insert(out.end(), MAGIC, MAGIC + sizeof(MAGIC));
+    put_word(out, VERSION);
+    put_word(out, rom_crc);
+    put_word(out, seed);
+    put_word(out, entropy);
+    put_word(out, SETTINGS);
+    for (int i = 0; i < SETTINGS; i++)
+        put_word(out, (uint32_t) settings[i]);
+    out.insert(out.end(), data.begin(), data.end());
+
+    if (!filestream_write_file(filename.c_str(), &out[0], out.size()) && log_cb)
+        log_cb(RETRO_LOG_ERROR, "Cannot write input log: %s\n", filename.c_str());
+}
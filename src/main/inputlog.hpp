@@ -0,0 +1,113 @@
+/***************************************************************************
+    Input Log.
+
+    Records the player's input each engine tick, so a session can be
+    played back exactly. Used for bug reports, performance regression
+    runs and attract mode content.
+
+    The log starts with a header holding the settings that affect the
+    engine, a checksum of the program ROMs and the random seeds. This is
+    followed by one entry per change in the controls, holding the number
+    of ticks the previous controls were held for.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "globals.hpp"
+
+class StateBuf;
+
+class InputLog
+{
+public:
+    enum
+    {
+        MODE_OFF,
+        MODE_RECORD,
+        MODE_PLAYBACK,
+    };
+
+    InputLog();
+    ~InputLog();
+
+    // Select the mode and file to use from the next game onwards
+    void set_mode(int mode, const char* filename);
+
+    // Call when a new game is initialised, before the engine is initialised.
+    // On playback, the recorded settings are applied.
+    void start();
+
+    // Finish the current log. A recording is written to disk.
+    void stop();
+
+    // Call once per engine tick, before controls are processed.
+    // Records the controls, or replaces them with those from the log.
+    void tick();
+
+    // Save or restore the position in the log with the engine state
+    void sync_state(StateBuf& state);
+
+    bool recording() { return active && mode == MODE_RECORD; }
+    bool playing()   { return active && mode == MODE_PLAYBACK; }
+
+private:
+    // Number of settings stored in the header
+    static const int SETTINGS = 25;
+
+    // Controls held for one tick
+    struct controls_t
+    {
+        uint32_t keys; // Bit per Input::presses
+        uint32_t wheel;
+        uint32_t accel;
+        uint32_t brake;
+    };
+
+    int mode;
+    std::string filename;
+
+    // A log is being recorded or played back
+    bool active;
+
+    // Header has been completed or checked on the first tick
+    bool first_tick;
+
+    // Changes with every log started, so states saved during another log are recognised
+    uint32_t session;
+
+    uint32_t rom_crc;
+    uint32_t seed;
+    uint32_t entropy;
+    int32_t settings[SETTINGS];
+
+    // Settings in use before playback, restored afterwards
+    int32_t user_settings[SETTINGS];
+
+    // Encoded entries
+    std::vector<uint8_t> data;
+    uint32_t pos;
+
+    // Controls for the current run of ticks, and ticks remaining in that run
+    controls_t controls;
+    uint32_t run;
+
+    // Controls of the previous entry, which the next entry holds changes from
+    controls_t base;
+
+    void sync_settings(int32_t* values, bool apply);
+    uint32_t calc_rom_crc();
+    void read_controls();
+    void write_controls();
+    void put_entry(const controls_t& next, uint32_t ticks);
+    bool get_entry();
+    bool load();
+    void save();
+};
+
+extern ENGINE_GLOBAL InputLog inputlog;
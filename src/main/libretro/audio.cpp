@@ -4,8 +4,9 @@
     It takes the output from the PCM and YM chips, mixes them and then
     outputs appropriately.
     
-    In order to achieve seamless audio, when audio is enabled the framerate
-    is adjusted to essentially sync the video to the audio output.
+    In order to achieve seamless audio, the number of samples output each
+    frame can be adjusted, using the occupancy of the frontend's audio 
+    buffer, to keep it from running dry or overflowing.
     
     This is based upon code from the Atari800 emulator project.
     Copyright (c) 1998-2008 Atari800 development team
@@ -16,32 +17,40 @@
 #include "audio.hpp"
 #include "frontend/config.hpp" // fps
 #include "engine/audio/osoundint.hpp"
+#include "trace.hpp"
 #include <libretro.h>
+#include <file/file_path.h>
 
-extern retro_log_printf_t                 log_cb;
-
-#ifdef __PS3__
-#define free std::free
+#ifdef USE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #endif
 
+extern retro_log_printf_t                 log_cb;
+
 extern retro_audio_sample_batch_t  audio_batch_cb;
 
 #ifdef COMPILE_SOUND_CODE
 
-/* ----------------------------------------------------------------------------
-   SDL Sound Implementation & Callback Function
-   ----------------------------------------------------------------------------*/
+#ifdef USE_THREADS
+// Synthesis thread. Only the hand-off of each frame's job is locked.
+// Mixed samples are passed back through the lock-free ring.
+static std::thread*            worker = NULL;
+static std::mutex              worker_lock;
+static std::condition_variable worker_cv;
+static bool                    job_pending;
+static bool                    worker_quit;
+static OSoundInt::frame_t      job;
+static uint32_t                job_samples;
+#endif
 
-// Note that these variables are accessed by two separate threads.
-uint8_t* dsp_buffer;
-static int dsp_buffer_bytes;
-static int dsp_write_pos;
-static int dsp_read_pos;
-static int bytes_per_sample; // Number of bytes per sample entry (usually 4 bytes if stereo and 16-bit sound)
+const double Audio::MAX_RATE_DELTA = 0.005;
 
 Audio::Audio()
 {
-
+    output = true;
+    sound  = &osoundint;
 }
 
 Audio::~Audio()
@@ -59,216 +68,289 @@ void Audio::start_audio()
 {
     if (!sound_enabled)
     {
-        bytes_per_sample = CHANNELS * (BITS / 8);
-
         // Start Audio
         sound_enabled = true;
 
-        // how many fragments in the dsp buffer
-        const int DSP_BUFFER_FRAGS = 5;
-        int specified_delay_samps = (FREQ * SND_DELAY) / 1000;
-        int dsp_buffer_samps = SAMPLES * DSP_BUFFER_FRAGS + specified_delay_samps;
-        dsp_buffer_bytes = CHANNELS * dsp_buffer_samps * (BITS / 8);
-        dsp_buffer = new uint8_t[dsp_buffer_bytes];
-
-        // Create Buffer For Mixing
-        uint16_t buffer_size = (FREQ / config.fps) * CHANNELS;
-        mix_buffer = new uint16_t[buffer_size];
+        // Create Buffer For Mixing. Sized for the largest frame (30fps).
+        ring.init(SoundChip::max_frame_size(config.sound.rate, 30));
+        music_buffer = new int16_t[SoundChip::max_frame_size(config.sound.rate, 30) * CHANNELS];
 
         clear_buffers();
         clear_wav();
+
+        if (threaded)
+            start_worker();
     }
 }
 
 void Audio::clear_buffers()
 {
-    dsp_read_pos  = 0;
-    int specified_delay_samps = (FREQ * SND_DELAY) / 1000;
-    dsp_write_pos = (specified_delay_samps+SAMPLES) * bytes_per_sample;
-
-    for (int i = 0; i < dsp_buffer_bytes; i++)
-        dsp_buffer[i] = 0;
-
-    uint16_t buffer_size = (FREQ / config.fps) * CHANNELS;
-    for (int i = 0; i < buffer_size; i++)
-        mix_buffer[i] = 0;
+    ring.clear();
+    sample_acc = 0;
 }
 
 void Audio::stop_audio()
 {
     if (sound_enabled)
     {
+        stop_worker();
+        clear_wav();
         sound_enabled = false;
 
-        delete[] dsp_buffer;
-        delete[] mix_buffer;
+        delete[] music_buffer;
     }
 }
 
-void Audio::pause_audio()
+void Audio::set_threaded(bool enabled)
 {
+    threaded = enabled;
+
+    if (!sound_enabled)
+        return;
+
+    if (threaded)
+        start_worker();
+    else
+        stop_worker();
 }
 
-void Audio::resume_audio()
+void Audio::set_buffer_status(bool active, uint32_t occupancy)
 {
-    if (sound_enabled)
-        clear_buffers();
+    buffer_active    = active;
+    buffer_occupancy = occupancy;
 }
 
-// Called every frame to update the audio
-void Audio::tick()
+void Audio::set_output(bool enabled)
 {
-   static unsigned SND_RATE      = 44100;
-    int bytes_written = 0;
-    int newpos;
-
-    if (!sound_enabled)
-       return;
+    output = enabled;
+}
 
-    // Update audio streams from PCM & YM Devices
-    osoundint.pcm->stream_update();
-    osoundint.ym->stream_update();
+void Audio::start_worker()
+{
+#ifdef USE_THREADS
+    if (worker == NULL)
+    {
+        job_pending = false;
+        worker_quit = false;
+        worker      = new std::thread(worker_loop, this);
+    }
+#endif
+}
 
-    // Get the audio buffers we've just output
-    int16_t *pcm_buffer = osoundint.pcm->get_buffer();
-    int16_t *ym_buffer  = osoundint.ym->get_buffer();
-    int16_t *wav_buffer = wavfile.data;
+void Audio::stop_worker()
+{
+#ifdef USE_THREADS
+    if (worker != NULL)
+    {
+        {
+            std::lock_guard<std::mutex> guard(worker_lock);
+            worker_quit = true;
+            worker_cv.notify_all();
+        }
+        worker->join();
+        delete worker;
+        worker = NULL;
+    }
+#endif
+}
 
-    int samples_written = osoundint.pcm->buffer_size;
+#ifdef USE_THREADS
+void Audio::worker_loop(Audio* audio)
+{
+    trace::name_thread("Audio");
+    std::unique_lock<std::mutex> guard(worker_lock);
 
-    // And mix them into the mix_buffer
-    for (int i = 0; i < samples_written; i++)
+    for (;;)
     {
-        int32_t mix_data = wav_buffer[wavfile.pos] + pcm_buffer[i] + ym_buffer[i];
+        while (!job_pending && !worker_quit)
+            worker_cv.wait(guard);
 
-        // Clip mix data
-        if (mix_data >= (1 << 15))
-            mix_data = (1 << 15);
-        else if (mix_data < -(1 << 15))
-            mix_data = -(1 << 15);
+        if (worker_quit)
+            break;
 
-        mix_buffer[i] = mix_data;
+        guard.unlock();
+        audio->sound->run_frame(&job, job_samples);
+        audio->mix(job_samples);
+        guard.lock();
 
-        // Loop wav files
-        if (++wavfile.pos >= wavfile.length)
-            wavfile.pos = 0;
+        job_pending = false;
+        worker_cv.notify_all();
     }
+}
+#else
+void Audio::worker_loop(Audio* audio) {}
+#endif
 
-    // Cast mix_buffer to a byte array, to align it with internal SDL format 
-    uint8_t* mbuf8 = (uint8_t*) mix_buffer;
+void Audio::pause_audio()
+{
+}
 
-    // produce samples from the sound emulation
-    bytes_written = (BITS == 8 ? samples_written : samples_written*2);
-    
-    // now we copy the data into the buffer and adjust the positions
-    newpos = dsp_write_pos + bytes_written;
-    if (newpos/dsp_buffer_bytes == dsp_write_pos/dsp_buffer_bytes) 
+void Audio::resume_audio()
+{
+    if (sound_enabled)
+        clear_buffers();
+}
+
+// Called every frame to run the sound program code and update the audio.
+//
+// When threaded, the commands from the main program code are latched and
+// the Z80 program and sound chips are run on the synthesis thread, while
+// the frame is rendered. flush() then collects the result.
+void Audio::tick()
+{
+    trace::Scope phase("audio.tick");
+
+    if (!sound_enabled)
     {
-        // no wrap
-        memcpy(dsp_buffer+(dsp_write_pos%dsp_buffer_bytes), mbuf8, bytes_written);
+        osoundint.tick(0);
+        return;
     }
-    else 
+
+    // Audio will be discarded. Run the sound program and advance the chips by a nominal frame, so that their
+    // state is unaffected, but skip rendering PCM samples and the mix. The fractional sample count is left alone.
+    if (!output)
     {
-        // wraps
-        int first_part_size = dsp_buffer_bytes - (dsp_write_pos%dsp_buffer_bytes);
-        memcpy(dsp_buffer+(dsp_write_pos%dsp_buffer_bytes), mbuf8, first_part_size);
-        memcpy(dsp_buffer, mbuf8+first_part_size, bytes_written-first_part_size);
+        osoundint.pcm->set_silent(true);
+        osoundint.tick(config.sound.rate / config.fps);
+        osoundint.pcm->set_silent(false);
+        return;
     }
-    dsp_write_pos = newpos;
 
-    // Sound callback has not yet been called
-    dsp_read_pos += bytes_written;
+    const uint32_t samples = frame_samples();
 
-    while (dsp_read_pos > dsp_buffer_bytes) 
+#ifdef USE_THREADS
+    if (worker != NULL)
     {
-        dsp_write_pos -= dsp_buffer_bytes;
-        dsp_read_pos -= dsp_buffer_bytes;
+        // The worker is idle here, as flush() waits for it at the end of every frame
+        osoundint.latch_frame(&job);
+        job_samples = samples;
+
+        std::lock_guard<std::mutex> guard(worker_lock);
+        job_pending = true;
+        worker_cv.notify_all();
+        return;
     }
+#endif
 
-   int audio_frames = SND_RATE / config.fps;
-   audio_batch_cb((int16_t*)mix_buffer, audio_frames);
+    osoundint.tick(samples);
+    mix(samples);
 }
 
-// Empty Wav Buffer
-static int16_t EMPTY_BUFFER[] = {0, 0, 0, 0};
+// Number of samples to output this frame.
+//
+// The nominal rate is rarely a whole number of samples per frame (44100 / 120 = 367.5), so the remainder
+// is carried between frames. With rate control enabled, the rate is nudged by up to MAX_RATE_DELTA, 
+// towards holding the frontend's buffer at half occupancy.
+uint32_t Audio::frame_samples()
+{
+    double target = (double) config.sound.rate / config.fps;
 
-void Audio::load_wav(const char* filename)
+    if (config.sound.rate_control && buffer_active)
+        target *= 1.0 + (MAX_RATE_DELTA * (50.0 - buffer_occupancy) / 50.0);
+
+    sample_acc += target;
+    uint32_t samples = (uint32_t) sample_acc;
+    sample_acc -= samples;
+
+    const uint32_t max = SoundChip::max_frame_size(config.sound.rate, config.fps);
+    return samples > max ? max : samples;
+}
+
+// Wait for this frame's audio and pass it to the frontend
+void Audio::flush()
 {
     if (!sound_enabled)
-       return;
+        return;
 
-#if 0
-   /* TODO/FIXME */
+    // Includes any wait for the synthesis thread
+    trace::Scope phase("audio.flush");
+
+#ifdef USE_THREADS
+    if (worker != NULL)
     {
-        clear_wav();
+        std::unique_lock<std::mutex> guard(worker_lock);
+        while (job_pending)
+            worker_cv.wait(guard);
+    }
+#endif
 
-        // Load Wav File
-        SDL_AudioSpec wave;
-    
-        uint8_t *data;
-        uint32_t length;
+    uint32_t samples;
+    int16_t* block;
+    while ((block = ring.read_slot(&samples)) != NULL)
+    {
+        audio_batch_cb(block, samples);
+        ring.release();
+    }
+}
 
-        pause_audio();
+// Mix the audio streams rendered by the sound chips this frame.
+// Mixing, clipping and the music overlay are done in a single pass, directly into the block passed to the frontend.
+void Audio::mix(uint32_t samples)
+{
+    trace::Scope phase("audio.mix");
 
-        if( SDL_LoadWAV(filename, &wave, &data, &length) == NULL)
-        {
-            wavfile.loaded = 0;
-            resume_audio();
-            log_cb(RETRO_LOG_ERROR, "Could not load WAV: %s\n", filename);
-            return;
-        }
-        
-        // Halve Volume Of Wav File
-        uint8_t* data_vol = new uint8_t[length];
-        SDL_MixAudio(data_vol, data, length, SDL_MIX_MAXVOLUME / 2);
+    // Get the audio buffers we've just output
+    const int16_t* pcm_buffer = sound->pcm->get_buffer();
+    const int16_t* ym_buffer  = sound->ym->get_buffer();
 
-        // WAV File Needs Conversion To Target Format
-        if (wave.format != AUDIO_S16 || wave.channels != 2 || wave.freq != FREQ)
+    // Consumer has fallen behind. Drop the block.
+    int16_t* mix_buffer = ring.write_slot();
+    if (mix_buffer == NULL)
+        return;
+
+    const uint32_t length = samples * CHANNELS;
+
+    if (music.render(music_buffer, samples))
+    {
+        for (uint32_t i = 0; i < length; i++)
         {
-            SDL_AudioCVT cvt;
-            SDL_BuildAudioCVT(&cvt, wave.format, wave.channels, wave.freq,
-                                    AUDIO_S16,   CHANNELS,      FREQ);
-
-            cvt.buf = (uint8_t*) malloc(length*cvt.len_mult);
-            memcpy(cvt.buf, data_vol, length);
-            cvt.len = length;
-            SDL_ConvertAudio(&cvt);
-            SDL_FreeWAV(data);
-            delete[] data_vol;
-
-            wavfile.data = (int16_t*) cvt.buf;
-            wavfile.length = cvt.len_cvt / 2;
-            wavfile.pos = 0;
-            wavfile.loaded = 1;
+            int32_t mix_data = music_buffer[i] + pcm_buffer[i] + ym_buffer[i];
+
+            // Clip mix data
+            if (mix_data > INT16_MAX)
+                mix_data = INT16_MAX;
+            else if (mix_data < INT16_MIN)
+                mix_data = INT16_MIN;
+
+            mix_buffer[i] = (int16_t) mix_data;
         }
-        // No Conversion Needed
-        else
+    }
+    else
+    {
+        for (uint32_t i = 0; i < length; i++)
         {
-            SDL_FreeWAV(data);
-            wavfile.data = (int16_t*) data_vol;
-            wavfile.length = length / 2;
-            wavfile.pos = 0;
-            wavfile.loaded = 2;
-        }
+            int32_t mix_data = pcm_buffer[i] + ym_buffer[i];
+
+            // Clip mix data
+            if (mix_data > INT16_MAX)
+                mix_data = INT16_MAX;
+            else if (mix_data < INT16_MIN)
+                mix_data = INT16_MIN;
 
-        resume_audio();
+            mix_buffer[i] = (int16_t) mix_data;
+        }
     }
-#endif
+
+    ring.commit(samples);
 }
 
-void Audio::clear_wav()
+// Start streaming a custom music track from the content directory
+void Audio::load_wav(const char* filename)
 {
-    if (wavfile.loaded)
-    {
-        if (wavfile.loaded == 1)
-            free(wavfile.data);
-        else
-            delete[] wavfile.data;        
-    }
+    extern char rom_path[1024];
+
+    if (!sound_enabled)
+       return;
+
+    char path[1024];
+    fill_pathname_join(path, rom_path, filename, sizeof(path));
+
+    // Called from game code, so the synthesis thread is idle and not mixing from the stream
+    music.open(path, config.sound.rate);
+}
 
-    wavfile.length = 1;
-    wavfile.data   = EMPTY_BUFFER;
-    wavfile.pos    = 0;
-    wavfile.loaded = false;
+void Audio::clear_wav()
+{
+    music.close();
 }
 #endif
@@ -4,8 +4,9 @@
     It takes the output from the PCM and YM chips, mixes them and then
     outputs appropriately.
     
-    In order to achieve seamless audio, when audio is enabled the framerate
-    is adjusted to essentially sync the video to the audio output.
+    In order to achieve seamless audio, the number of samples output each
+    frame can be adjusted, using the occupancy of the frontend's audio 
+    buffer, to keep it from running dry or overflowing.
     
     This is based upon code from the Atari800 emulator project.
     Copyright (c) 1998-2008 Atari800 development team
@@ -14,15 +15,12 @@
 #pragma once
 
 #include "globals.hpp"
+#include "audioring.hpp"
+#include "musicstream.hpp"
 
-#ifdef COMPILE_SOUND_CODE
+class OSoundInt;
 
-struct wav_t {
-    uint8_t loaded;
-    int16_t *data;
-    uint32_t pos;
-    uint32_t length;
-};
+#ifdef COMPILE_SOUND_CODE
 
 class Audio
 {
@@ -30,39 +28,61 @@ public:
     // Enable/Disable Sound
     bool sound_enabled;
 
+    // Sound program code and chips are run on a separate thread
+    bool threaded;
+
     Audio();
     ~Audio();
 
     void init();
     void tick();
+    void flush();
+    void set_threaded(bool enabled);
+    void set_buffer_status(bool active, uint32_t occupancy);
+    void set_output(bool enabled);
     void start_audio();
     void stop_audio();
     void load_wav(const char* filename);
     void clear_wav();
 
 private:
-    // Sample Rate. Can't be changed easily for now, due to lack of SDL resampling.
-    static const uint32_t FREQ = 44100;
-
     // Stereo. Could be changed, requires some recoding.
     static const uint32_t CHANNELS = 2;
 
     // 16-Bit Audio Output. Could be changed, requires some recoding.
     static const uint32_t BITS = 16;
 
-    // Low value  = Responsiveness, chance of drop out.
-    // High value = Laggy, less chance of drop out.
-    static const uint32_t SAMPLES  = 1024;
+    // Maximum adjustment made to the output rate by rate control (0.5%)
+    static const double MAX_RATE_DELTA;
+
+    // Frontend wants this frame's audio. Disabled on frames run ahead, whose audio is discarded.
+    bool output;
+
+    // Frontend audio buffer status
+    bool buffer_active;
+    uint32_t buffer_occupancy; // 0 - 100
+
+    // Fractional samples carried between frames
+    double sample_acc;
+
+    // Mixed blocks waiting to be passed to the frontend
+    AudioRing ring;
 
-    // Latency (in ms) and thus target buffer size
-    const static int SND_DELAY = 20;
+    // Custom music, streamed from file
+    MusicStream music;
 
-    // Buffer used to mix PCM and YM channels together
-    uint16_t* mix_buffer;
+    // Custom music, resampled to the output rate for the current frame
+    int16_t* music_buffer;
 
-    wav_t wavfile;
+    // Sound interface of the thread that owns this audio, for use on the synthesis thread
+    OSoundInt* sound;
 
+    uint32_t frame_samples();
+    void mix(uint32_t samples);
     void clear_buffers();
+    void start_worker();
+    void stop_worker();
+    static void worker_loop(Audio* audio);
     void pause_audio();
     void resume_audio();
 };
@@ -0,0 +1,103 @@
+/***************************************************************************
+    Audio Block Ring.
+
+    Single producer, single consumer ring of mixed stereo blocks. The
+    producer (the synthesis thread, or the main thread when running
+    unthreaded) mixes directly into a free slot and commits it. The
+    consumer hands committed slots straight to the frontend.
+
+    No locks are taken: each index is only ever written by one side.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef USE_THREADS
+#include <atomic>
+#endif
+
+class AudioRing
+{
+public:
+    // Number of blocks that can be in flight
+    static const uint32_t SLOTS = 4;
+
+    AudioRing()
+    {
+        data = NULL;
+        slot_size = 0;
+        clear();
+    }
+
+    ~AudioRing()
+    {
+        delete[] data;
+    }
+
+    // Allocate slots large enough for the given number of stereo samples.
+    void init(uint32_t samples)
+    {
+        delete[] data;
+        slot_size = samples * 2;
+        data      = new int16_t[slot_size * SLOTS];
+        clear();
+    }
+
+    // Only safe when neither side is active.
+    void clear()
+    {
+        for (uint32_t i = 0; i < SLOTS; i++)
+            frames[i] = 0;
+        head = 0;
+        tail = 0;
+    }
+
+    // Producer: Next free slot, or NULL if the consumer has fallen behind.
+    int16_t* write_slot()
+    {
+        uint32_t h = head;
+        if (h - tail >= SLOTS)
+            return NULL;
+        return data + ((h % SLOTS) * slot_size);
+    }
+
+    // Producer: Publish the slot returned by write_slot()
+    void commit(uint32_t samples)
+    {
+        uint32_t h = head;
+        frames[h % SLOTS] = samples;
+        head = h + 1;
+    }
+
+    // Consumer: Oldest committed slot, or NULL if empty.
+    int16_t* read_slot(uint32_t* samples)
+    {
+        uint32_t t = tail;
+        if (t == head)
+            return NULL;
+        *samples = frames[t % SLOTS];
+        return data + ((t % SLOTS) * slot_size);
+    }
+
+    // Consumer: Return the slot returned by read_slot() to the producer
+    void release()
+    {
+        tail = tail + 1;
+    }
+
+private:
+    int16_t* data;
+    uint32_t slot_size;
+    uint32_t frames[SLOTS];
+
+#ifdef USE_THREADS
+    std::atomic<uint32_t> head, tail;
+#else
+    uint32_t head, tail;
+#endif
+};
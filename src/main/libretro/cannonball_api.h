@@ -0,0 +1,102 @@
+/***************************************************************************
+    Cannonball Core Extensions.
+
+    Functions exported by the core alongside the libretro API, for tools
+    that load the core directly: Test harnesses, benchmarks and AI
+    driving research.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#ifndef CANNONBALL_API_H
+#define CANNONBALL_API_H
+
+#include <stdint.h>
+#include <libretro.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* State of the player's car after an engine tick */
+struct cannonball_telemetry
+{
+   uint32_t tick;          /* Engine tick counter (30 per second) */
+   int32_t  game_state;    /* Outrun game state (GS_*) */
+   int32_t  stage;         /* Current stage (0 - 4 deep, starting at 0) */
+   int32_t  time;          /* Time remaining, as shown on the HUD (BCD) */
+   uint32_t score;         /* Score (BCD) */
+   uint32_t road_pos;      /* Distance along the course */
+   int32_t  car_x;         /* Horizontal position of the car. 0 is the centre of the road. */
+   int32_t  road_width;    /* Half width of the road */
+   int32_t  speed;         /* Speed, as shown on the HUD */
+   int32_t  revs;
+   int32_t  gear;          /* 0 = Low, 1 = High */
+   int32_t  wheels_off;    /* 0 = On road, 1 = Left wheel off, 2 = Right wheel off, 3 = Both off */
+   int32_t  slipping;      /* Non-zero while skidding */
+   int32_t  crashed;       /* Crash sequence state. 0 = No crash */
+   int32_t  steering;      /* Controls as seen by the engine: -0x7F (left) to 0x7F (right) */
+   int32_t  accel;         /* 0 - 0xFF */
+   int32_t  brake;         /* 0 - 0xFF */
+};
+
+typedef void (*cannonball_telemetry_t)(const struct cannonball_telemetry *telemetry);
+
+/* Hash of the engine state after the latest engine tick, when Deterministic
+ * Mode is enabled. Runs with the same settings and input should match tick
+ * for tick, on every platform. */
+RETRO_API uint32_t cannonball_debug_state_hash(uint32_t *tick);
+
+/* Routine profiler: Call counts and timings for the ported routines of the game engine,
+ * tagged with the address of the original 68000 routine. Only available when the core
+ * is built with PROFILE_ROUTINES=1: Otherwise these return false.
+ * Start clears the totals. Dump stops profiling and writes the totals, as JSON when the
+ * path ends in .json, otherwise as CSV. */
+RETRO_API bool cannonball_debug_profile_start(void);
+RETRO_API bool cannonball_debug_profile_dump(const char *path);
+
+/* Run the game engine for the given number of ticks, as fast as possible,
+ * without rendering or audio. The input is polled once and held for every
+ * tick. Call in place of retro_run() once a game is in progress.
+ * Returns the number of ticks run: 0 when not in game. */
+RETRO_API unsigned cannonball_sim_run(unsigned ticks);
+
+/* Telemetry for the latest engine tick. Returns false before the first tick. */
+RETRO_API bool cannonball_sim_get_telemetry(struct cannonball_telemetry *telemetry);
+
+/* Called after every engine tick, in normal play and in headless simulation. NULL to remove. */
+RETRO_API void cannonball_sim_set_telemetry_callback(cannonball_telemetry_t callback);
+
+/* Engine contexts: Independent games, each run on a thread of its own, for running many
+ * simulations in parallel. A context copies the settings of the running game and boots into
+ * attract mode. It shares the loaded ROMs, so create contexts after retro_load_game().
+ * Only available when the core is built with ENGINE_TLS=1: Otherwise create returns NULL. */
+typedef struct cannonball_sim_context cannonball_sim_context_t;
+
+/* Buttons for cannonball_sim_context_set_controls() */
+#define CANNONBALL_SIM_GEAR1 (1 << 6)
+#define CANNONBALL_SIM_GEAR2 (1 << 7)
+#define CANNONBALL_SIM_START (1 << 8)
+#define CANNONBALL_SIM_COIN  (1 << 9)
+
+RETRO_API cannonball_sim_context_t *cannonball_sim_context_create(void);
+RETRO_API void cannonball_sim_context_destroy(cannonball_sim_context_t *context);
+
+/* Controls held from the next run onwards. Wheel: 0x48 (left) to 0xB8 (right), 0x80 is centre.
+ * Pedals: 0 - 0xFF. Buttons are held too, so a press is seen once. */
+RETRO_API void cannonball_sim_context_set_controls(cannonball_sim_context_t *context,
+      int32_t wheel, int32_t accel, int32_t brake, uint32_t buttons);
+
+/* Start running the given number of ticks, and return immediately */
+RETRO_API void cannonball_sim_context_run(cannonball_sim_context_t *context, unsigned ticks);
+
+/* Wait for the run to finish. Returns the number of ticks run, and the telemetry after the last. */
+RETRO_API unsigned cannonball_sim_context_wait(cannonball_sim_context_t *context,
+      struct cannonball_telemetry *telemetry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -11,7 +11,7 @@
 #include <string.h>
 #include "input.hpp"
 
-Input input;
+ENGINE_GLOBAL Input input;
 
 Input::Input(void)
 {
@@ -10,6 +10,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "globals.hpp"
 
 class Input
 {
@@ -86,4 +87,4 @@ private:
     int pedals_dead;
 };
 
-extern Input input;
+extern ENGINE_GLOBAL Input input;
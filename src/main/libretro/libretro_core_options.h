@@ -143,6 +143,23 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       "Smooth (60)"
 #endif
    },
+   {
+      "cannonball_video_refresh",
+      "Video > Display Refresh Rate",
+      "Display Refresh Rate",
+      "Output frames at the refresh rate of the display, blending the road, sprites and tilemap scrolling between frames of the game. The game runs at the Frame Rate set above, so this is far cheaper than a higher Frame Rate. Adds one game frame of latency. Has no effect unless above the Frame Rate.",
+      NULL,
+      "video",
+      {
+         { "disabled", NULL },
+         { "75",       "75Hz" },
+         { "120",      "120Hz" },
+         { "144",      "144Hz" },
+         { "240",      "240Hz" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
    {
       "cannonball_video_widescreen",
       "Video > Widescreen Mode",
@@ -175,6 +192,102 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "OFF"
    },
+   {
+      "cannonball_frameskip",
+      "Video > Frameskip",
+      "Frameskip",
+      "Skip rendering of frames to avoid audio buffer under-run (crackling). Improves performance at the expense of visual smoothness. Game logic and audio are not affected. 'Auto' skips frames when advised by the frontend. 'Manual' utilises the 'Frameskip Threshold (%)' setting. 'Auto (Frame Time)' skips frames when the core misses its frame time budget, for systems that struggle with demanding video settings.",
+      NULL,
+      "video",
+      {
+         { "disabled", NULL },
+         { "auto",     "Auto" },
+         { "manual",   "Manual" },
+         { "timing",   "Auto (Frame Time)" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "cannonball_frameskip_threshold",
+      "Video > Frameskip Threshold (%)",
+      "Frameskip Threshold (%)",
+      "When 'Frameskip' is set to 'Manual', specifies the audio buffer occupancy threshold (percentage) below which frames will be skipped. Higher values reduce the risk of crackling by causing frames to be dropped more frequently.",
+      NULL,
+      "video",
+      {
+         { "15", NULL },
+         { "18", NULL },
+         { "21", NULL },
+         { "24", NULL },
+         { "27", NULL },
+         { "30", NULL },
+         { "33", NULL },
+         { "36", NULL },
+         { "39", NULL },
+         { "42", NULL },
+         { "45", NULL },
+         { "48", NULL },
+         { "51", NULL },
+         { "54", NULL },
+         { "57", NULL },
+         { "60", NULL },
+         { NULL, NULL },
+      },
+      "33"
+   },
+   {
+      "cannonball_frameskip_budget",
+      "Video > Frameskip Budget (%)",
+      "Frameskip Budget (%)",
+      "When 'Frameskip' is set to 'Auto (Frame Time)', the next frame is skipped if the core spent longer than this percentage of the frame time on the last one. Lower values leave more time for the frontend, at the cost of dropping frames more frequently.",
+      NULL,
+      "video",
+      {
+         { "50",  NULL },
+         { "60",  NULL },
+         { "70",  NULL },
+         { "80",  NULL },
+         { "90",  NULL },
+         { "100", NULL },
+         { NULL, NULL },
+      },
+      "80"
+   },
+   {
+      "cannonball_frameskip_max",
+      "Video > Frameskip Max Consecutive",
+      "Frameskip Max Consecutive",
+      "When 'Frameskip' is set to 'Auto (Frame Time)', the maximum number of frames skipped in a row. The picture is always updated at least this often, even when the budget cannot be met.",
+      NULL,
+      "video",
+      {
+         { "1", NULL },
+         { "2", NULL },
+         { "3", NULL },
+         { "4", NULL },
+         { "5", NULL },
+         { "6", NULL },
+         { "8", NULL },
+         { "10", NULL },
+         { NULL, NULL },
+      },
+      "2"
+   },
+   {
+      "cannonball_perf_hud",
+      "Video > Performance HUD",
+      "Performance HUD",
+      "Show where the time goes each frame: The time taken by the game logic, each video layer, the palette and the sound chips (milliseconds, averaged over 30 frames), a graph of recent frame times against the frame budget with the 99th percentile and worst case, the number of sprites drawn and the channels playing on each sound chip.",
+      NULL,
+      "video",
+      {
+         { "OFF", NULL },
+         { "ON",  NULL },
+         { NULL, NULL },
+      },
+      "OFF"
+   },
    {
       "cannonball_sound_enable",
       "Audio > Enable",
@@ -231,6 +344,66 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "ON"
    },
+   {
+      "cannonball_sound_custom_music",
+      "Audio > Custom Music",
+      "Custom Music",
+      "Replace the in-game music with WAV files placed in the game content directory. 'track1.wav' to 'track3.wav' replace the three selectable tracks, 'track4.wav' replaces the high score music. Files are streamed from disk.",
+      NULL,
+      "audio",
+      {
+         { "OFF", NULL },
+         { "ON",  NULL },
+         { NULL, NULL },
+      },
+      "OFF"
+   },
+   {
+      "cannonball_sound_rate",
+      "Audio > Sample Rate",
+      "Sample Rate",
+      "Set the output sample rate. The sound chips are emulated directly at this rate. Lower values reduce CPU usage.",
+      NULL,
+      "audio",
+      {
+         { "22050", "22050 Hz" },
+         { "32000", "32000 Hz" },
+         { "44100", "44100 Hz" },
+         { "48000", "48000 Hz" },
+         { NULL, NULL },
+      },
+      "44100"
+   },
+   {
+      "cannonball_sound_rate_control",
+      "Audio > Dynamic Rate Control",
+      "Dynamic Rate Control",
+      "Vary the number of samples output each frame by up to 0.5%, using the occupancy of the frontend's audio buffer, to avoid under-runs and over-runs. Only needed when the frontend's own rate control is disabled.",
+      NULL,
+      "audio",
+      {
+         { "OFF", NULL },
+         { "ON",  NULL },
+         { NULL, NULL },
+      },
+      "OFF"
+   },
+#ifdef USE_THREADS
+   {
+      "cannonball_sound_thread",
+      "Audio > Threaded Synthesis",
+      "Threaded Synthesis",
+      "Run the sound program code and sound chip emulation on a separate thread, in parallel with video rendering. Can improve performance on multi-core devices.",
+      NULL,
+      "audio",
+      {
+         { "OFF", NULL },
+         { "ON",  NULL },
+         { NULL, NULL },
+      },
+      "OFF"
+   },
+#endif
    {
       "cannonball_gear",
       "Input > Gear Mode",
@@ -458,6 +631,20 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "ON"
    },
+   {
+      "cannonball_deterministic",
+      "Engine > Deterministic Mode (Restart)",
+      "Deterministic Mode (Restart)",
+      "Seed all randomness from a fixed value at the start of each game, so the same input always plays out the same way on every platform. For input log playback, netplay and regression testing. A hash of the engine state is taken each tick, for comparing runs.",
+      NULL,
+      "engine",
+      {
+         { "OFF", NULL },
+         { "ON",  NULL },
+         { NULL, NULL },
+      },
+      "OFF"
+   },
    {
       "cannonball_fix_bugs",
       "Engine > Fix Game Bugs (Restart)",
@@ -486,6 +673,20 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "OFF"
    },
+   {
+      "cannonball_sprite_limits",
+      "Engine > Original Sprite Limits",
+      "Original Sprite Limits",
+      "Drop sprites past the limits of the original game, as it did on crowded sections of track. Disable to draw every sprite the hardware has room for, such as on densely populated custom tracks.",
+      NULL,
+      "engine",
+      {
+         { "ON",  NULL },
+         { "OFF", NULL },
+         { NULL, NULL },
+      },
+      "ON"
+   },
    {
       "cannonball_ttrial_laps",
       "Engine > Time Trial Laps (Restart)",
@@ -545,6 +746,118 @@ struct retro_core_option_v2_definition option_defs_us[] = {
       },
       "3"
    },
+   {
+      "cannonball_rewind",
+      "Engine > Rewind",
+      "Rewind",
+      "Keep a history of play, which can be wound back by holding L3. Independent of the frontend's own rewind. 'Time Trial' keeps history in Time Trial mode only, for practice sessions.",
+      NULL,
+      "engine",
+      {
+         { "disabled", NULL },
+         { "ttrial",   "Time Trial" },
+         { "enabled",  "Always" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "cannonball_rewind_buffer",
+      "Engine > Rewind Buffer Size",
+      "Rewind Buffer Size",
+      "Memory used to hold the rewind history. When full, the oldest history is discarded.",
+      NULL,
+      "engine",
+      {
+         { "2",  "2 MB" },
+         { "4",  "4 MB" },
+         { "8",  "8 MB" },
+         { "16", "16 MB" },
+         { "32", "32 MB" },
+         { "64", "64 MB" },
+         { NULL, NULL },
+      },
+      "8"
+   },
+   {
+      "cannonball_rewind_granularity",
+      "Engine > Rewind Granularity",
+      "Rewind Granularity",
+      "Number of game ticks (30 per second) between each point in the rewind history. Higher values hold a longer history in the same memory, but rewind in larger steps.",
+      NULL,
+      "engine",
+      {
+         { "1",  NULL },
+         { "2",  NULL },
+         { "3",  NULL },
+         { "4",  NULL },
+         { "5",  NULL },
+         { "10", NULL },
+         { NULL, NULL },
+      },
+      "2"
+   },
+   {
+      "cannonball_headless",
+      "Engine > Headless Simulation",
+      "Headless Simulation",
+      "Run the game logic many times faster than real time, with no picture or sound, for soak tests and AI driving research. Sets the number of game ticks run each frame once a game is under way. Car telemetry is available to tools through the core's cannonball_sim_* functions.",
+      NULL,
+      "engine",
+      {
+         { "disabled", NULL },
+         { "10",       "10 Ticks/Frame" },
+         { "100",      "100 Ticks/Frame" },
+         { "1000",     "1000 Ticks/Frame" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "cannonball_input_log",
+      "Engine > Input Log",
+      "Input Log",
+      "Record the controls of each game to 'input_log.cbi' in the save directory, or play them back. The recording includes the engine settings and random seed, so playback reproduces the game exactly. Takes effect from the next game started.",
+      NULL,
+      "engine",
+      {
+         { "disabled", NULL },
+         { "record",   "Record" },
+         { "playback", "Playback" },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+   {
+      "cannonball_trace",
+      "Engine > Frame Trace Capture",
+      "Frame Trace Capture",
+      "Record the time taken by each part of every frame (controls, game logic, sound and each layer of the video) to 'cannonball_trace.json' in the save directory, until disabled again. Open the file in chrome://tracing or ui.perfetto.dev to find the cause of slow frames. Each capture replaces the last.",
+      NULL,
+      "engine",
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#ifdef PROFILE_ROUTINES
+   {
+      "cannonball_profile",
+      "Engine > Routine Profiler",
+      "Routine Profiler",
+      "Count the calls to, and time spent in, the ported routines of the game engine. The totals are written to 'routine_profile.csv' and 'routine_profile.json' in the save directory when disabled again, or when the game is closed.",
+      NULL,
+      "engine",
+      {
+         { "disabled", NULL },
+         { "enabled",  NULL },
+         { NULL, NULL },
+      },
+      "disabled"
+   },
+#endif
    {
       "cannonball_layout_debug",
       "Engine > Display Debug Info (Restart)",
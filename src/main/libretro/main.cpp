@@ -16,6 +16,7 @@
 
 #include <libretro.h>
 #include "libretro_core_options.h"
+#include "cannonball_api.h"
 
 #include "input.hpp"
 #include "video.hpp"
@@ -24,6 +25,15 @@
 #include "trackloader.hpp"
 #include "main.hpp"
 #include "lr_setup.hpp"
+#include "utils.hpp"
+#include "savestate.hpp"
+#include "rewind.hpp"
+#include "inputlog.hpp"
+#include "timing.hpp"
+#include "trace.hpp"
+#include "perfhud.hpp"
+#include "profiler.hpp"
+#include "enginecontext.hpp"
 #include "engine/outrun.hpp"
 #include "frontend/config.hpp"
 #include "frontend/menu.hpp"
@@ -32,6 +42,11 @@
 #include "engine/oinputs.hpp"
 #include "engine/ooutputs.hpp"
 #include "engine/omusic.hpp"
+#include "engine/ocrash.hpp"
+#include "engine/oferrari.hpp"
+#include "engine/oinitengine.hpp"
+#include "engine/ostats.hpp"
+#include "engine/audio/osoundint.hpp"
 
 #include "lr_options.hpp"
 
@@ -41,13 +56,13 @@
 // Initialize Shared Variables
 using namespace cannonball;
 
-int cannonball::state = STATE_BOOT;
-int cannonball::frame = 0;
-bool cannonball::tick_frame = true;
-int cannonball::fps_counter = 0;
+ENGINE_GLOBAL int cannonball::state = STATE_BOOT;
+ENGINE_GLOBAL int cannonball::frame = 0;
+ENGINE_GLOBAL bool cannonball::tick_frame = true;
+ENGINE_GLOBAL int cannonball::fps_counter = 0;
 
 #ifdef COMPILE_SOUND_CODE
-Audio cannonball::audio;
+ENGINE_GLOBAL Audio cannonball::audio;
 #endif
 
 Menu *menu;
@@ -80,6 +95,7 @@ static void config_init(void)
    config.video.fps = 2; // Default is 60 fps
 #endif
    config.video.fps_count = 0; // FPS Counter
+   config.video.refresh = 0;   // Interpolated frames disabled
 #ifdef DINGUX
    config.video.widescreen = 0; // Enable Widescreen Mode
 #else
@@ -88,8 +104,6 @@ static void config_init(void)
    config.video.hires = 0;     // Hi-Resolution Mode
    config.video.filtering = 0; // Open GL Filtering Mode
 
-   config.set_fps(config.video.fps);
-
    // ------------------------------------------------------------------------
    // Sound Settings
    // ------------------------------------------------------------------------
@@ -101,19 +115,20 @@ static void config_init(void)
    config.sound.advertise = 1;
    config.sound.preview = 1;
    config.sound.fix_samples = 1;
+   config.sound.threaded = 0;
+   config.sound.rate = 44100;
+   config.sound.rate_control = 0;
 
-#if 0
-    // Custom Music
-    for (int i = 0; i < 4; i++)
-    {
-        std::string xmltag = "sound.custom_music.track";
-        xmltag += Utils::to_string(i+1);  
-
-        config.sound.custom_music[i].enabled = pt_config.get(xmltag + ".<xmlattr>.enabled", 0);
-        config.sound.custom_music[i].title   = pt_config.get(xmltag + ".title", "TRACK " +Utils::to_string(i+1));
-        config.sound.custom_music[i].filename= pt_config.get(xmltag + ".filename", "track"+Utils::to_string(i+1)+".wav");
-    }
-#endif
+   // Sound chips are initialised at the selected frame rate and sample rate
+   config.set_fps(config.video.fps);
+
+   // Custom Music. Enabled by the core option, when the file is present in the content directory.
+   for (int i = 0; i < 4; i++)
+   {
+      config.sound.custom_music[i].enabled  = 0;
+      config.sound.custom_music[i].title    = "TRACK " + Utils::to_string(i+1);
+      config.sound.custom_music[i].filename = "track" + Utils::to_string(i+1) + ".wav";
+   }
 
 #ifdef CANNONBOARD
    // ------------------------------------------------------------------------
@@ -188,8 +203,10 @@ static void config_init(void)
    config.engine.fix_bugs_backup =
        config.engine.fix_bugs = 1;
    config.engine.fix_timer = 0;
+   config.engine.sprite_limits = 1;
    config.engine.layout_debug = 0;
    config.engine.new_attract = 1;
+   config.engine.deterministic = 0;
 
    // ------------------------------------------------------------------------
    // Time Trial Mode
@@ -213,16 +230,73 @@ retro_audio_sample_batch_t audio_batch_cb;
 
 static bool libretro_fps_record_inhibit = false;
 static int libretro_fps_prev = 0;
+static int libretro_rate_prev = 0;
+
+// Frameskip
+static const uint16_t FRAMESKIP_MAX = 30; // Maximum consecutive frames skipped
+static unsigned frameskip_type      = 0;  // 0 = Disabled, 1 = Auto, 2 = Manual, 3 = Auto (Frame Time)
+static unsigned frameskip_threshold = 33; // Manual: skip when buffer occupancy (%) drops below
+static unsigned frameskip_budget    = 80; // Frame Time: skip when the last frame took more than this (%) of the frame time
+static uint16_t frameskip_max       = 2;  // Frame Time: maximum consecutive frames skipped
+static uint16_t frameskip_counter   = 0;
+static uint64_t frame_start         = 0;  // Time retro_run started (Nanoseconds)
+static uint64_t frame_cost          = 0;  // Time the core spent on the last frame (Nanoseconds)
+static bool libretro_can_dupe       = false;
+
+/* Rewind */
+static unsigned rewind_mode      = 0; // 0 = Disabled, 1 = Time Trial Only, 2 = Always
+static unsigned rewind_size_mb   = 8;
+static unsigned rewind_interval  = 2; // Game ticks between snapshots
+
+/* Input Log */
+static int input_log_mode = InputLog::MODE_OFF; // Applied when the next game starts
+
+/* Deterministic Mode: Engine state hash after the latest tick */
+static uint32_t state_hash = 0;
+static uint32_t state_hash_tick = 0;
+
+/* Routine Profiler core option: Totals are written when it is disabled */
+#ifdef PROFILE_ROUTINES
+static bool profile_enabled = false;
+#endif
+
+/* Frame Tracing: Capturing to the trace file */
+static bool trace_capture = false;
+
+/* Headless Simulation: Game ticks to run per frame, with no rendering or audio. 0 = Disabled. */
+static unsigned headless_ticks = 0;
+
+/* Car telemetry after the latest tick */
+static struct cannonball_telemetry telemetry;
+static bool telemetry_valid = false;
+static cannonball_telemetry_t telemetry_cb = NULL;
+
+// Frontend audio buffer status
+static bool retro_audio_buff_active        = false;
+static unsigned retro_audio_buff_occupancy = 0;
+static bool retro_audio_buff_underrun      = false;
+
+static unsigned audio_latency     = 0;
+static bool update_audio_latency  = false;
 
 char rom_path[1024];
 
 char FILENAME_SCORES[1024];
 char FILENAME_TTRIAL[1024];
 char FILENAME_CONT[1024];
+static char FILENAME_INPUTLOG[1024];
+static char FILENAME_TRACE[1024];
+#ifdef PROFILE_ROUTINES
+static char FILENAME_PROFILE_CSV[1024];
+static char FILENAME_PROFILE_JSON[1024];
+#endif
 
 static bool option_visibility_set = false;
 static bool sound_enable_prev = true;
 static bool analog_enable_prev = true;
+static bool frameskip_manual_prev = true;
+static bool frameskip_timing_prev = true;
+static bool rewind_enable_prev = true;
 
 static bool update_option_visibility(void)
 {
@@ -230,6 +304,9 @@ static bool update_option_visibility(void)
    struct retro_core_option_display option_display = {0};
    bool sound_enable = true;
    bool analog_enable = true;
+   bool frameskip_manual = false;
+   bool frameskip_timing = false;
+   bool rewind_enable = false;
    bool updated = false;
 
    /* Check if sound is enabled */
@@ -265,6 +342,20 @@ static bool update_option_visibility(void)
       option_display.key = "cannonball_sound_fix_samples";
       environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
 
+      option_display.key = "cannonball_sound_rate";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      option_display.key = "cannonball_sound_rate_control";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      option_display.key = "cannonball_sound_custom_music";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+#ifdef USE_THREADS
+      option_display.key = "cannonball_sound_thread";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+#endif
+
       sound_enable_prev = sound_enable;
       updated = true;
    }
@@ -285,6 +376,62 @@ static bool update_option_visibility(void)
       updated = true;
    }
 
+   /* Frameskip threshold only applies in manual mode, budget and maximum in frame time mode */
+   var.key = "cannonball_frameskip";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      frameskip_manual = (strcmp(var.value, "manual") == 0);
+      frameskip_timing = (strcmp(var.value, "timing") == 0);
+   }
+
+   if ((frameskip_manual != frameskip_manual_prev) ||
+       (!option_visibility_set && !frameskip_manual))
+   {
+      option_display.visible = frameskip_manual;
+      option_display.key = "cannonball_frameskip_threshold";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      frameskip_manual_prev = frameskip_manual;
+      updated = true;
+   }
+
+   if ((frameskip_timing != frameskip_timing_prev) ||
+       (!option_visibility_set && !frameskip_timing))
+   {
+      option_display.visible = frameskip_timing;
+      option_display.key = "cannonball_frameskip_budget";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+      option_display.key = "cannonball_frameskip_max";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      frameskip_timing_prev = frameskip_timing;
+      updated = true;
+   }
+
+   /* Rewind buffer options only apply when rewind is enabled */
+   var.key = "cannonball_rewind";
+   var.value = NULL;
+
+   rewind_enable = environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) &&
+                   var.value && (strcmp(var.value, "disabled") != 0);
+
+   if ((rewind_enable != rewind_enable_prev) ||
+       (!option_visibility_set && !rewind_enable))
+   {
+      option_display.visible = rewind_enable;
+
+      option_display.key = "cannonball_rewind_buffer";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      option_display.key = "cannonball_rewind_granularity";
+      environ_cb(RETRO_ENVIRONMENT_SET_CORE_OPTIONS_DISPLAY, &option_display);
+
+      rewind_enable_prev = rewind_enable;
+      updated = true;
+   }
+
    option_visibility_set = true;
    return updated;
 }
@@ -341,10 +488,130 @@ void update_geometry()
    environ_cb(RETRO_ENVIRONMENT_SET_GEOMETRY, &av_info);
 }
 
+static void retro_audio_buff_status_cb(bool active, unsigned occupancy, bool underrun_likely)
+{
+   retro_audio_buff_active    = active;
+   retro_audio_buff_occupancy = occupancy;
+   retro_audio_buff_underrun  = underrun_likely;
+
+#ifdef COMPILE_SOUND_CODE
+   cannonball::audio.set_buffer_status(active, occupancy);
+#endif
+}
+
+// Monitor the frontend's audio buffer when frameskip or rate control need it
+static void init_audio_buff_status(void)
+{
+   bool monitor = config.sound.enabled && (frameskip_type == 1 || frameskip_type == 2 || config.sound.rate_control);
+
+   if (monitor)
+   {
+      struct retro_audio_buffer_status_callback buf_status_cb;
+      buf_status_cb.callback = retro_audio_buff_status_cb;
+
+      if (!environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, &buf_status_cb))
+      {
+         if (log_cb)
+            log_cb(RETRO_LOG_WARN, "[Cannonball]: Frameskip and rate control disabled - frontend does not support audio buffer status monitoring.\n");
+         monitor = false;
+      }
+   }
+   else
+      environ_cb(RETRO_ENVIRONMENT_SET_AUDIO_BUFFER_STATUS_CALLBACK, NULL);
+
+   if (monitor)
+   {
+      /* Increase frontend audio latency to minimise
+       * potential buffer underruns: 6x the frame time,
+       * rounded up to the nearest multiple of 32ms */
+      float frame_time_msec = 1000.0f / (float) config.fps;
+      audio_latency = (unsigned) ((6.0f * frame_time_msec) + 0.5f);
+      audio_latency = (audio_latency + 0x1F) & ~0x1F;
+   }
+   else
+   {
+      retro_audio_buff_status_cb(false, 0, false);
+      audio_latency = 0;
+   }
+
+   update_audio_latency = true;
+}
+
+// Frames per second output to the frontend: The display refresh rate when interpolating, or the engine rate
+static int display_rate(void)
+{
+   return config.video.refresh > config.fps ? config.video.refresh : config.fps;
+}
+
+// Decide whether to skip rendering this frame. Game logic and audio always run.
+static bool check_frameskip(void)
+{
+   bool skip_frame = false;
+   uint16_t max_skip = FRAMESKIP_MAX;
+
+   if (!libretro_can_dupe)
+      return false;
+
+   switch (frameskip_type)
+   {
+   case 1: /* Auto */
+      skip_frame = retro_audio_buff_active && retro_audio_buff_underrun;
+      break;
+   case 2: /* Manual */
+      skip_frame = retro_audio_buff_active && (retro_audio_buff_occupancy < frameskip_threshold);
+      break;
+   case 3: /* Auto (Frame Time): The last frame overran its share of the frame time */
+      skip_frame = frame_cost * 100 > (uint64_t) frameskip_budget * 1000000000ULL / display_rate();
+      max_skip = frameskip_max;
+      break;
+   default:
+      break;
+   }
+
+   if (skip_frame && frameskip_counter < max_skip)
+   {
+      frameskip_counter++;
+      return true;
+   }
+
+   frameskip_counter = 0;
+   return false;
+}
+
+// Enable custom music tracks whose files are present in the content directory
+static void update_custom_music(bool enabled)
+{
+   for (int i = 0; i < 4; i++)
+   {
+      char path[1024];
+      fill_pathname_join(path, rom_path, config.sound.custom_music[i].filename.c_str(), sizeof(path));
+      config.sound.custom_music[i].enabled = enabled && path_is_valid(path);
+   }
+}
+
+#ifdef PROFILE_ROUTINES
+// Routine Profiler core option: Write the totals to the save directory
+static void write_profile(void)
+{
+   if (FILENAME_PROFILE_CSV[0] == '\0')
+      return;
+
+   if (cannonball_debug_profile_dump(FILENAME_PROFILE_CSV) &&
+       cannonball_debug_profile_dump(FILENAME_PROFILE_JSON))
+   {
+      if (log_cb)
+         log_cb(RETRO_LOG_INFO, "[Cannonball]: Routine profile written to: %s\n", FILENAME_PROFILE_CSV);
+   }
+   else if (log_cb)
+      log_cb(RETRO_LOG_WARN, "[Cannonball]: Cannot write routine profile: %s\n", FILENAME_PROFILE_CSV);
+}
+#endif
+
 static void update_variables(bool startup)
 {
    bool geometry_update = false;
    bool timing_update = false;
+   bool audio_buff_update = startup;
    struct retro_variable var;
 
    var.key = "cannonball_menu_enabled";
@@ -389,6 +656,17 @@ static void update_variables(bool startup)
       }
    }
 
+   var.key = "cannonball_video_refresh";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (strcmp(var.value, "disabled") == 0)
+         config.video.refresh = 0;
+      else
+         config.video.refresh = atoi(var.value);
+   }
+
    var.key = "cannonball_video_widescreen";
    var.value = NULL;
 
@@ -442,6 +720,7 @@ static void update_variables(bool startup)
       if (newval != config.sound.enabled)
       {
          config.sound.enabled = newval;
+         audio_buff_update = true;
 #ifdef COMPILE_SOUND_CODE
          if (config.sound.enabled)
             cannonball::audio.start_audio();
@@ -451,6 +730,224 @@ static void update_variables(bool startup)
       }
    }
 
+   var.key = "cannonball_sound_custom_music";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      update_custom_music(strcmp(var.value, "ON") == 0);
+
+   var.key = "cannonball_sound_rate_control";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      int newval = 0;
+
+      if (strcmp(var.value, "ON") == 0)
+         newval = 1;
+      else if (strcmp(var.value, "OFF") == 0)
+         newval = 0;
+
+      if (newval != config.sound.rate_control)
+      {
+         config.sound.rate_control = newval;
+         audio_buff_update = true;
+      }
+   }
+
+   var.key = "cannonball_frameskip";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      unsigned newval = 0;
+
+      if (strcmp(var.value, "auto") == 0)
+         newval = 1;
+      else if (strcmp(var.value, "manual") == 0)
+         newval = 2;
+      else if (strcmp(var.value, "timing") == 0)
+         newval = 3;
+
+      if (newval != frameskip_type)
+      {
+         frameskip_type = newval;
+         audio_buff_update = true;
+      }
+   }
+
+   var.key = "cannonball_frameskip_threshold";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      frameskip_threshold = strtol(var.value, NULL, 10);
+
+   var.key = "cannonball_frameskip_budget";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      frameskip_budget = strtol(var.value, NULL, 10);
+
+   var.key = "cannonball_frameskip_max";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      frameskip_max = strtol(var.value, NULL, 10);
+
+   var.key = "cannonball_perf_hud";
+   var.value = NULL;
+
+   bool hud = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      hud = (strcmp(var.value, "ON") == 0);
+
+   // The HUD shows the subsystem timings, so these are collected while it is shown
+   if (hud != perfhud::enabled)
+   {
+      timing::enabled  = hud;
+      perfhud::enabled = hud;
+      perfhud::reset();
+   }
+
+   {
+      unsigned mode     = 0;
+      unsigned size_mb  = rewind_size_mb;
+      unsigned interval = rewind_interval;
+
+      var.key = "cannonball_rewind";
+      var.value = NULL;
+
+      if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      {
+         if (strcmp(var.value, "ttrial") == 0)
+            mode = 1;
+         else if (strcmp(var.value, "enabled") == 0)
+            mode = 2;
+      }
+
+      var.key = "cannonball_rewind_buffer";
+      var.value = NULL;
+
+      if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+         size_mb = strtol(var.value, NULL, 10);
+
+      var.key = "cannonball_rewind_granularity";
+      var.value = NULL;
+
+      if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+         interval = strtol(var.value, NULL, 10);
+
+      /* Resizing the buffer discards the history, so only do so on change */
+      if (mode == 0)
+         rewind_buffer.disable();
+      else if (!rewind_buffer.is_enabled() || size_mb != rewind_size_mb || interval != rewind_interval)
+         rewind_buffer.init(size_mb << 20, interval);
+
+      rewind_mode     = mode;
+      rewind_size_mb  = size_mb;
+      rewind_interval = interval;
+   }
+
+   var.key = "cannonball_headless";
+   var.value = NULL;
+
+   headless_ticks = 0;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value &&
+       strcmp(var.value, "disabled") != 0)
+      headless_ticks = strtol(var.value, NULL, 10);
+
+   var.key = "cannonball_input_log";
+   var.value = NULL;
+
+   input_log_mode = InputLog::MODE_OFF;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (strcmp(var.value, "record") == 0)
+         input_log_mode = InputLog::MODE_RECORD;
+      else if (strcmp(var.value, "playback") == 0)
+         input_log_mode = InputLog::MODE_PLAYBACK;
+   }
+
+   var.key = "cannonball_trace";
+   var.value = NULL;
+
+   bool capture = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      capture = (strcmp(var.value, "enabled") == 0);
+
+   if (capture != trace_capture)
+   {
+      if (!capture)
+         trace::stop();
+      else if (!trace::start(FILENAME_TRACE) && log_cb)
+         log_cb(RETRO_LOG_WARN, "[Cannonball]: Cannot write frame trace: %s\n", FILENAME_TRACE);
+      trace_capture = capture;
+   }
+
+#ifdef PROFILE_ROUTINES
+   var.key = "cannonball_profile";
+   var.value = NULL;
+
+   bool profile = false;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+      profile = (strcmp(var.value, "enabled") == 0);
+
+   if (profile != profile_enabled)
+   {
+      if (profile)
+         cannonball_debug_profile_start();
+      else
+         write_profile();
+      profile_enabled = profile;
+   }
+#endif
+
+   var.key = "cannonball_sound_rate";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      int newval = atoi(var.value);
+
+      if (newval != 22050 && newval != 32000 && newval != 48000)
+         newval = 44100;
+
+      if (newval != config.sound.rate)
+      {
+         config.sound.rate = newval;
+         // Sound chips are re-initialised alongside the frame rate
+         timing_update = true;
+      }
+   }
+
+#ifdef USE_THREADS
+   var.key = "cannonball_sound_thread";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      unsigned int newval = 0;
+
+      if (strcmp(var.value, "ON") == 0)
+         newval = 1;
+      else if (strcmp(var.value, "OFF") == 0)
+         newval = 0;
+
+      if (newval != config.sound.threaded)
+      {
+         config.sound.threaded = newval;
+#ifdef COMPILE_SOUND_CODE
+         cannonball::audio.set_threaded(newval != 0);
+#endif
+      }
+   }
+#endif
+
    var.key = "cannonball_gear";
    var.value = NULL;
 
@@ -696,6 +1193,17 @@ static void update_variables(bool startup)
          config.engine.randomgen = 1;
    }
 
+   var.key = "cannonball_deterministic";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (strcmp(var.value, "ON") == 0)
+         config.engine.deterministic = 1;
+      else if (strcmp(var.value, "OFF") == 0)
+         config.engine.deterministic = 0;
+   }
+
    var.key = "cannonball_fix_bugs";
    var.value = NULL;
 
@@ -718,6 +1226,17 @@ static void update_variables(bool startup)
          config.engine.fix_timer = 0;
    }
 
+   var.key = "cannonball_sprite_limits";
+   var.value = NULL;
+
+   if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE, &var) && var.value)
+   {
+      if (strcmp(var.value, "ON") == 0)
+         config.engine.sprite_limits = 1;
+      else if (strcmp(var.value, "OFF") == 0)
+         config.engine.sprite_limits = 0;
+   }
+
    var.key = "cannonball_ttrial_laps";
    var.value = NULL;
 
@@ -763,7 +1282,14 @@ end:
    }
 
    if (timing_update)
+   {
       config.set_fps(config.video.fps);
+      // Requested latency depends on the frame time
+      audio_buff_update = true;
+   }
+
+   if (audio_buff_update)
+      init_audio_buff_status();
 
    /* Show/hide core options */
    update_option_visibility();
@@ -788,11 +1314,11 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
 
    memset(info, 0, sizeof(*info));
 
-   info->timing.fps = config.fps;
-   /* Due to integer rounding errors (44100/102 = 367.5),
-    * we produce fewer than the expected 44100 samples
-    * per second when running at 120 fps... */
-   info->timing.sample_rate = (config.fps == 120) ? 44040 : 44100;
+   info->timing.fps = display_rate();
+   /* Fractional samples per frame (44100/120 = 367.5)
+    * are carried between frames by the audio code,
+    * so the full sample rate is always output */
+   info->timing.sample_rate = config.sound.rate;
 
    info->geometry.max_width = S16_WIDTH_WIDE << 1;
    info->geometry.max_height = S16_HEIGHT << 1;
@@ -811,7 +1337,10 @@ void retro_get_system_av_info(struct retro_system_av_info *info)
    }
 
    if (!libretro_fps_record_inhibit)
-      libretro_fps_prev = config.fps;
+   {
+      libretro_fps_prev  = display_rate();
+      libretro_rate_prev = config.sound.rate;
+   }
 }
 
 void update_timing(void)
@@ -829,17 +1358,23 @@ void retro_set_controller_port_device(unsigned port, unsigned device)
 
 size_t retro_serialize_size(void)
 {
-   return 0;
+   return savestate::size();
 }
 
 bool retro_serialize(void *data, size_t size)
 {
-   return false;
+   return savestate::save(data, size);
 }
 
 bool retro_unserialize(const void *data, size_t size)
 {
-   return false;
+   // The input log moves back with the engine. See InputLog::sync_state()
+   if (!savestate::load(data, size))
+      return false;
+
+   // Ticks after the state loaded were rolled back, so drop them from the rewind history
+   rewind_buffer.state_loaded(outrun.tick_counter);
+   return true;
 }
 
 void retro_cheat_reset(void) {}
@@ -889,6 +1424,12 @@ static void retro_build_save_paths(void)
    FILENAME_SCORES[0] = '\0';
    FILENAME_TTRIAL[0] = '\0';
    FILENAME_CONT[0] = '\0';
+   FILENAME_INPUTLOG[0] = '\0';
+   FILENAME_TRACE[0] = '\0';
+#ifdef PROFILE_ROUTINES
+   FILENAME_PROFILE_CSV[0] = '\0';
+   FILENAME_PROFILE_JSON[0] = '\0';
+#endif
 
    /* Get frontend save directory
     * > Use game data directory as a fallback if
@@ -908,6 +1449,20 @@ static void retro_build_save_paths(void)
 
    fill_pathname_join(FILENAME_CONT, save_dir,
                       "hiscores_continuous", sizeof(FILENAME_CONT));
+
+   fill_pathname_join(FILENAME_INPUTLOG, save_dir,
+                      "input_log.cbi", sizeof(FILENAME_INPUTLOG));
+
+   fill_pathname_join(FILENAME_TRACE, save_dir,
+                      "cannonball_trace.json", sizeof(FILENAME_TRACE));
+
+#ifdef PROFILE_ROUTINES
+   fill_pathname_join(FILENAME_PROFILE_CSV, save_dir,
+                      "routine_profile.csv", sizeof(FILENAME_PROFILE_CSV));
+
+   fill_pathname_join(FILENAME_PROFILE_JSON, save_dir,
+                      "routine_profile.json", sizeof(FILENAME_PROFILE_JSON));
+#endif
 }
 
 bool retro_load_game(const struct retro_game_info *info)
@@ -929,6 +1484,7 @@ bool retro_load_game(const struct retro_game_info *info)
        {0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R, "Go Back To Menu"},
        {0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L2, "Analog Brake"},
        {0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_R2, "Analog Accelerate"},
+       {0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L3, "Rewind (Hold)"},
        {0, RETRO_DEVICE_ANALOG, RETRO_DEVICE_INDEX_ANALOG_LEFT, RETRO_DEVICE_ID_ANALOG_X, "Analog X"},
        {0, RETRO_DEVICE_ANALOG, RETRO_DEVICE_INDEX_ANALOG_LEFT, RETRO_DEVICE_ID_ANALOG_Y, "Analog Y"},
 
@@ -978,6 +1534,9 @@ bool retro_load_game(const struct retro_game_info *info)
       return false;
    }
 
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_CAN_DUPE, &libretro_can_dupe))
+      libretro_can_dupe = false;
+
    config_init();
 
    update_variables(true);
@@ -1043,6 +1602,15 @@ void retro_unload_game(void)
 {
 #ifdef COMPILE_SOUND_CODE
    audio.stop_audio();
+#endif
+   rewind_buffer.disable();
+   inputlog.stop();
+   trace::stop();
+   trace_capture = false;
+#ifdef PROFILE_ROUTINES
+   if (profile_enabled)
+      write_profile();
+   profile_enabled = false;
 #endif
    input.close();
    forcefeedback::close();
@@ -1054,6 +1622,95 @@ unsigned retro_get_region(void)
    return RETRO_REGION_NTSC;
 }
 
+/* Core extensions. See cannonball_api.h */
+uint32_t cannonball_debug_state_hash(uint32_t *tick)
+{
+   if (tick)
+      *tick = state_hash_tick;
+   return state_hash;
+}
+
+bool cannonball_debug_profile_start(void)
+{
+#ifdef PROFILE_ROUTINES
+   profiler::start();
+   return true;
+#else
+   return false;
+#endif
+}
+
+bool cannonball_debug_profile_dump(const char *path)
+{
+#ifdef PROFILE_ROUTINES
+   if (string_is_empty(path))
+      return false;
+
+   profiler::stop();
+
+   if (string_is_equal_noncase(path_get_extension(path), "json"))
+      return profiler::dump_json(path);
+   return profiler::dump_csv(path);
+#else
+   return false;
+#endif
+}
+
+bool cannonball_sim_get_telemetry(struct cannonball_telemetry *t)
+{
+   if (!telemetry_valid || !t)
+      return false;
+
+   *t = telemetry;
+   return true;
+}
+
+void cannonball_sim_set_telemetry_callback(cannonball_telemetry_t callback)
+{
+   telemetry_cb = callback;
+}
+
+struct cannonball_sim_context
+{
+   EngineContext engine;
+};
+
+cannonball_sim_context_t *cannonball_sim_context_create(void)
+{
+   // No game loaded
+   if (state == STATE_BOOT || state == STATE_QUIT)
+      return NULL;
+
+   cannonball_sim_context_t *context = new cannonball_sim_context_t;
+   if (!context->engine.start())
+   {
+      delete context;
+      return NULL;
+   }
+   return context;
+}
+
+void cannonball_sim_context_destroy(cannonball_sim_context_t *context)
+{
+   delete context;
+}
+
+void cannonball_sim_context_set_controls(cannonball_sim_context_t *context,
+      int32_t wheel, int32_t accel, int32_t brake, uint32_t buttons)
+{
+   context->engine.set_controls(wheel, accel, brake, buttons);
+}
+
+void cannonball_sim_context_run(cannonball_sim_context_t *context, unsigned ticks)
+{
+   context->engine.run(ticks);
+}
+
+unsigned cannonball_sim_context_wait(cannonball_sim_context_t *context, struct cannonball_telemetry *telemetry)
+{
+   return context->engine.wait(telemetry);
+}
+
 unsigned retro_api_version(void)
 {
    return RETRO_API_VERSION;
@@ -1088,6 +1745,9 @@ void retro_init(void)
 
    option_visibility_set = false;
    sound_enable_prev = true;
+   frameskip_manual_prev = true;
+   frameskip_timing_prev = true;
+   rewind_enable_prev = true;
    analog_enable_prev = true;
 }
 
@@ -1097,6 +1757,33 @@ void retro_deinit(void)
 
    libretro_fps_record_inhibit = false;
    libretro_fps_prev = 0;
+   libretro_rate_prev = 0;
+
+   frameskip_type             = 0;
+   frameskip_threshold        = 33;
+   frameskip_budget           = 80;
+   frameskip_max              = 2;
+   frameskip_counter          = 0;
+   frame_start                = 0;
+   frame_cost                 = 0;
+   libretro_can_dupe          = false;
+   rewind_mode                = 0;
+   rewind_size_mb             = 8;
+   rewind_interval            = 2;
+   input_log_mode             = InputLog::MODE_OFF;
+   state_hash                 = 0;
+   state_hash_tick            = 0;
+   headless_ticks             = 0;
+   trace_capture              = false;
+   perfhud::enabled           = false;
+   timing::enabled            = false;
+   telemetry_valid            = false;
+   telemetry_cb               = NULL;
+   retro_audio_buff_active    = false;
+   retro_audio_buff_occupancy = 0;
+   retro_audio_buff_underrun  = false;
+   audio_latency              = 0;
+   update_audio_latency       = false;
 
    libretro_supports_bitmasks = false;
 }
@@ -1165,6 +1852,75 @@ static void process_events(void)
    input.handle_joy_axis(analog_left_x, analog_r2, analog_l2);
 }
 
+// Called at the end of each frame, once its audio is complete
+static void frame_done(void)
+{
+   if (frameskip_type != 3 && !perfhud::enabled)
+      return;
+
+   frame_cost = timing::now() - frame_start;
+
+   if (perfhud::enabled)
+      perfhud::frame_done(frame_cost, 1000000000ULL / display_rate());
+}
+
+// Called after each game tick. Publishes the state of the car, and its hash in Deterministic Mode.
+static void engine_tick_done(void)
+{
+   if (config.engine.deterministic)
+   {
+      state_hash      = savestate::hash();
+      state_hash_tick = outrun.tick_counter;
+   }
+
+   EngineContext::get_telemetry(&telemetry);
+   telemetry_valid = true;
+
+   if (telemetry_cb)
+      telemetry_cb(&telemetry);
+}
+
+// Run the game logic alone, as fast as possible. Drawing and the sound chips are skipped entirely. 
+// The sound program still runs, so its command queue is drained and play resumes cleanly afterwards.
+unsigned cannonball_sim_run(unsigned ticks)
+{
+   unsigned done = 0;
+
+   if (state != STATE_GAME)
+      return 0;
+
+   process_events();
+
+   while (done < ticks && state == STATE_GAME)
+   {
+      EngineContext::next_frame();
+
+      if (tick_frame)
+      {
+         oinputs.tick(NULL);
+         oinputs.do_gear();
+      }
+
+      {
+         timing::Scope t(timing::ENGINE);
+         outrun.tick(NULL, tick_frame);
+      }
+
+#ifdef COMPILE_SOUND_CODE
+      osoundint.tick(0);
+#endif
+
+      if (tick_frame)
+      {
+         input.frame_done();
+         engine_tick_done();
+         done++;
+      }
+   }
+
+   return done;
+}
+
 void retro_run(void)
 {
    bool updated = false;
@@ -1172,10 +1928,60 @@ void retro_run(void)
    if (environ_cb(RETRO_ENVIRONMENT_GET_VARIABLE_UPDATE, &updated) && updated)
       update_variables(false);
 
-   if (config.fps != libretro_fps_prev)
+   trace::poll();
+   trace::Scope phase("retro_run");
+
+   // Frame time frameskip and the performance HUD: Measure the core's own work, from here until the frame is output
+   if (frameskip_type == 3 || perfhud::enabled)
+      frame_start = timing::now();
+
+   if (display_rate() != libretro_fps_prev || config.sound.rate != libretro_rate_prev)
       update_timing();
 
-   frame++;
+   if (update_audio_latency)
+   {
+      environ_cb(RETRO_ENVIRONMENT_SET_MINIMUM_AUDIO_LATENCY, &audio_latency);
+      update_audio_latency = false;
+   }
+
+   // Run-ahead: The frontend discards the output of frames it runs ahead.
+   // These only need to advance the engine, so rendering and mixing are skipped.
+   int av_enable = 3;
+   if (!environ_cb(RETRO_ENVIRONMENT_GET_AUDIO_VIDEO_ENABLE, &av_enable))
+      av_enable = 3;
+
+   const bool video_enabled = (av_enable & 1) != 0;
+#ifdef COMPILE_SOUND_CODE
+   audio.set_output((av_enable & 2) != 0);
+#endif
+
+   // Headless simulation: Many game ticks per frame, with no picture or sound
+   if (headless_ticks && state == STATE_GAME)
+   {
+      cannonball_sim_run(headless_ticks);
+      video.skip_frame();
+      return;
+   }
+
+   // Interpolated frames: The display runs faster than the engine. Between engine frames,
+   // the last two engine frames are blended and nothing else is run.
+   const bool interpolate = config.video.refresh > config.fps;
+   if (interpolate)
+   {
+      if (!video.step_display(config.fps, config.video.refresh))
+      {
+         if (!video_enabled || check_frameskip())
+            video.skip_frame();
+         else
+            video.draw_frame(video.display_alpha);
+
+         frame_done();
+         return;
+      }
+      video.save_frame();
+   }
+
+   EngineContext::next_frame();
 
    // Get CannonBoard Packet Data
    Packet *packet = NULL;
@@ -1185,28 +1991,15 @@ void retro_run(void)
       packet = cannonboard.get_packet();
 #endif
 
-   switch (config.fps)
-   {
-   case 60:
-      /* 60 fps
-       * Non-standard: tick every second frame */
-      tick_frame = frame & 1;
-      break;
-   case 120:
-      /* 120 fps
-       * Non-standard: tick every fourth frame */
-      tick_frame = (frame & 3) == 1;
-      break;
-   case 30:
-   default:
-      /* 30 fps
-       * Standard rate: tick every frame */
-      tick_frame = true;
-      break;
-   }
-
    process_events();
 
+   // Core rewind: Held on L3, when history is being kept for the current game mode
+   const bool rewind_active = (rewind_mode == 2 ||
+                              (rewind_mode == 1 && outrun.cannonball_mode == Outrun::MODE_TTRIAL)) &&
+                              !inputlog.recording() && !inputlog.playing();
+   const bool rewind_held   = rewind_active &&
+                              input_state_cb(0, RETRO_DEVICE_JOYPAD, 0, RETRO_DEVICE_ID_JOYPAD_L3);
+
    if (tick_frame)
    {
       oinputs.tick(packet); // Do Controls
@@ -1217,6 +2010,17 @@ void retro_run(void)
    {
    case STATE_GAME:
    {
+      // Step back through the history instead of running the engine
+      if (rewind_held)
+      {
+         if (tick_frame)
+         {
+            rewind_buffer.step_back();
+            input.frame_done();
+         }
+         break;
+      }
+
       if (tick_frame)
       {
          if (input.has_pressed(Input::TIMER))
@@ -1229,16 +2033,24 @@ void retro_run(void)
 
       if (!pause_engine || input.has_pressed(Input::STEP))
       {
-         outrun.tick(packet, tick_frame);
+         {
+            timing::Scope t(timing::ENGINE);
+            outrun.tick(packet, tick_frame);
+         }
          if (tick_frame)
             input.frame_done();
 
 #ifdef COMPILE_SOUND_CODE
-         // Tick audio program code
-         osoundint.tick();
-         // Tick Audio
+         // Tick audio program code and sound chips
          audio.tick();
 #endif
+
+         if (tick_frame)
+            engine_tick_done();
+
+         // Every tick is recorded, including those run ahead. Loading a state drops ticks after it.
+         if (rewind_active && tick_frame)
+            rewind_buffer.capture(outrun.tick_counter);
       }
       else
       {
@@ -1249,6 +2061,10 @@ void retro_run(void)
    break;
 
    case STATE_INIT_GAME:
+      // Record or play back this game. Playback applies the recorded settings.
+      inputlog.set_mode(input_log_mode, FILENAME_INPUTLOG);
+      inputlog.start();
+
       if (config.engine.jap && !roms.load_japanese_roms())
       {
          state = STATE_QUIT;
@@ -1257,6 +2073,7 @@ void retro_run(void)
       {
          pause_engine = false;
          outrun.init();
+         rewind_buffer.clear();
          state = STATE_GAME;
       }
       break;
@@ -1266,15 +2083,14 @@ void retro_run(void)
       menu->tick(packet);
       input.frame_done();
 #ifdef COMPILE_SOUND_CODE
-      // Tick audio program code
-      osoundint.tick();
-      // Tick Audio
+      // Tick audio program code and sound chips
       audio.tick();
 #endif
    }
    break;
 
    case STATE_INIT_MENU:
+      inputlog.stop();
       oinputs.init();
       outrun.outputs->init();
       menu->init();
@@ -1292,8 +2108,18 @@ void retro_run(void)
       cannonboard.write(outrun.outputs->dig_out, outrun.outputs->hw_motor_control);
 #endif
 
-   // Draw Video
-   video.draw_frame();
+   // Draw Video, unless it will be discarded or the frame is being skipped to keep audio running smoothly
+   if (!video_enabled || check_frameskip())
+      video.skip_frame();
+   else
+      video.draw_frame(interpolate ? video.display_alpha : BLEND_ONE);
+
+#ifdef COMPILE_SOUND_CODE
+   // Output Audio, once the synthesis thread has caught up
+   audio.flush();
+#endif
+
+   frame_done();
 
    // Stop any haptic feedback effects if
    // duration timer has elapsed
@@ -0,0 +1,340 @@
+/***************************************************************************
+    Streaming Custom Music.
+
+    Plays custom music tracks without loading them into memory first.
+
+    The file is read in chunks through the libretro VFS and decoded into
+    a bounded ring of 16-bit stereo frames, at the file's own sample
+    rate. When threads are available this happens on a background
+    thread, so selecting a track never stalls the frame. Otherwise the
+    ring is topped up a chunk at a time as it drains.
+
+    The ring is resampled to the output rate as it is mixed. Tracks loop.
+
+    Supported formats: WAV (8/16/24/32-bit PCM, 32-bit float, mono or
+    stereo).
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <string.h>
+#include <libretro.h>
+#include <streams/file_stream.h>
+#include "musicstream.hpp"
+
+#ifdef USE_THREADS
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#endif
+
+extern retro_log_printf_t log_cb;
+
+#ifdef USE_THREADS
+// Decoder thread. Sleeps until the ring has room for another chunk.
+static std::thread*            decoder = NULL;
+static std::mutex              decoder_lock;
+static std::condition_variable decoder_cv;
+static bool                    decoder_quit;
+#endif
+
+static inline uint16_t read_le16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static inline uint32_t read_le32(const uint8_t* p) { return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t) p[3] << 24); }
+
+MusicStream::MusicStream()
+{
+    file  = NULL;
+    chunk = NULL;
+    ring  = new int16_t[RING_FRAMES * 2];
+    head  = 0;
+    tail  = 0;
+}
+
+MusicStream::~MusicStream()
+{
+    close();
+    delete[] ring;
+}
+
+bool MusicStream::open(const char* path, uint32_t out_rate)
+{
+    close();
+
+    file = filestream_open(path, RETRO_VFS_FILE_ACCESS_READ, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+    if (file == NULL)
+    {
+        log_cb(RETRO_LOG_ERROR, "Could not open music: %s\n", path);
+        return false;
+    }
+
+    if (!parse_header())
+    {
+        log_cb(RETRO_LOG_ERROR, "Unsupported music format: %s\n", path);
+        close();
+        return false;
+    }
+
+    chunk    = new uint8_t[CHUNK_FRAMES * block_align];
+    data_pos = 0;
+    head     = 0;
+    tail     = 0;
+    step     = (uint32_t) (((uint64_t) src_rate << 16) / out_rate);
+    frac     = 0x10000; // Fetch first frame immediately
+    prev[0]  = prev[1] = 0;
+    cur[0]   = cur[1]  = 0;
+
+    // Decode the opening chunk now, so playback starts without a gap
+    if (!decode_chunk())
+    {
+        close();
+        return false;
+    }
+
+    start_decoder();
+    return true;
+}
+
+void MusicStream::close()
+{
+    stop_decoder();
+
+    if (file != NULL)
+    {
+        filestream_close(file);
+        file = NULL;
+    }
+
+    delete[] chunk;
+    chunk = NULL;
+}
+
+// Find the format and data chunks of a RIFF WAVE file
+bool MusicStream::parse_header()
+{
+    uint8_t hdr[40];
+
+    if (filestream_read(file, hdr, 12) != 12 ||
+        memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0)
+        return false;
+
+    bool found_fmt = false;
+
+    for (;;)
+    {
+        if (filestream_read(file, hdr, 8) != 8)
+            return false;
+
+        const uint32_t size = read_le32(hdr + 4);
+
+        if (memcmp(hdr, "fmt ", 4) == 0)
+        {
+            if (size < 16 || size > sizeof(hdr) || filestream_read(file, hdr, size) != size)
+                return false;
+
+            format       = read_le16(hdr);
+            src_channels = read_le16(hdr + 2);
+            src_rate     = read_le32(hdr + 4);
+            block_align  = read_le16(hdr + 12);
+            src_bits     = read_le16(hdr + 14);
+
+            // Sub-format is held in the first two bytes of the GUID
+            if (format == FORMAT_EXTENSIBLE && size >= 26)
+                format = read_le16(hdr + 24);
+
+            found_fmt = true;
+        }
+        else if (memcmp(hdr, "data", 4) == 0)
+        {
+            data_start = filestream_tell(file);
+            data_size  = size - (size % (block_align ? block_align : 1));
+            break;
+        }
+        else if (filestream_seek(file, size + (size & 1), RETRO_VFS_SEEK_POSITION_CURRENT) < 0)
+            return false;
+    }
+
+    if (!found_fmt || src_rate == 0 || data_size == 0)
+        return false;
+
+    if (src_channels < 1 || src_channels > 2 || block_align != src_channels * (src_bits >> 3))
+        return false;
+
+    if (format == FORMAT_PCM)
+        return src_bits == 8 || src_bits == 16 || src_bits == 24 || src_bits == 32;
+    else if (format == FORMAT_FLOAT)
+        return src_bits == 32;
+
+    return false;
+}
+
+// Read and decode one chunk into the ring, if there is room for it
+bool MusicStream::decode_chunk()
+{
+    const uint32_t free_frames = RING_FRAMES - (head - tail);
+    if (free_frames < CHUNK_FRAMES)
+        return true;
+
+    // Loop at the end of the data
+    if (data_pos >= data_size)
+    {
+        if (filestream_seek(file, data_start, RETRO_VFS_SEEK_POSITION_START) < 0)
+            return false;
+        data_pos = 0;
+    }
+
+    uint32_t bytes = CHUNK_FRAMES * block_align;
+    if (bytes > data_size - data_pos)
+        bytes = data_size - data_pos;
+
+    int64_t read = filestream_read(file, chunk, bytes);
+    if (read <= 0)
+        return false;
+
+    data_pos += (uint32_t) read;
+
+    const uint32_t frames = (uint32_t) read / block_align;
+    uint32_t h = head;
+
+    for (uint32_t i = 0; i < frames; i++)
+    {
+        const uint8_t* src = chunk + (i * block_align);
+        int16_t* dst = ring + ((h & (RING_FRAMES - 1)) << 1);
+
+        for (uint16_t ch = 0; ch < src_channels; ch++)
+        {
+            int32_t v;
+            switch (src_bits)
+            {
+                case 8:  v = (src[0] - 0x80) << 8;                   src += 1; break;
+                case 16: v = (int16_t) read_le16(src);               src += 2; break;
+                case 24: v = (int16_t) read_le16(src + 1);           src += 3; break;
+                default:
+                    if (format == FORMAT_FLOAT)
+                    {
+                        uint32_t bits = read_le32(src);
+                        float f;
+                        memcpy(&f, &bits, 4);
+                        v = f >= 1.0f ? INT16_MAX : f <= -1.0f ? INT16_MIN : (int32_t) (f * 32767.0f);
+                    }
+                    else
+                        v = (int16_t) read_le16(src + 2);
+                    src += 4;
+                    break;
+            }
+            dst[ch] = (int16_t) v;
+        }
+
+        // Mono: Duplicate to both channels
+        if (src_channels == 1)
+            dst[1] = dst[0];
+
+        h++;
+    }
+
+    head = h;
+    return true;
+}
+
+bool MusicStream::fill()
+{
+    while (RING_FRAMES - (head - tail) >= CHUNK_FRAMES)
+    {
+        if (!decode_chunk())
+            return false;
+    }
+    return true;
+}
+
+bool MusicStream::render(int16_t* dst, uint32_t samples)
+{
+    if (file == NULL)
+        return false;
+
+#ifndef USE_THREADS
+    // No decoder thread: Top up the ring once it is half empty
+    if (head - tail < RING_FRAMES / 2)
+        fill();
+#endif
+
+    uint32_t t = tail;
+    const uint32_t h = head;
+
+    for (uint32_t i = 0; i < samples; i++)
+    {
+        while (frac >= 0x10000)
+        {
+            frac -= 0x10000;
+            prev[0] = cur[0];
+            prev[1] = cur[1];
+
+            // Hold the last frame if the decoder has fallen behind
+            if (t != h)
+            {
+                const int16_t* src = ring + ((t & (RING_FRAMES - 1)) << 1);
+                cur[0] = src[0];
+                cur[1] = src[1];
+                t++;
+            }
+        }
+
+        // Linear interpolation. Music is mixed at half volume.
+        const int32_t f = frac >> 1;
+        *dst++ = (int16_t) ((prev[0] + (((cur[0] - prev[0]) * f) >> 15)) >> 1);
+        *dst++ = (int16_t) ((prev[1] + (((cur[1] - prev[1]) * f) >> 15)) >> 1);
+        frac += step;
+    }
+
+    tail = t;
+
+#ifdef USE_THREADS
+    if (RING_FRAMES - (h - t) >= CHUNK_FRAMES)
+        decoder_cv.notify_one();
+#endif
+
+    return true;
+}
+
+void MusicStream::start_decoder()
+{
+#ifdef USE_THREADS
+    decoder_quit = false;
+    decoder = new std::thread([this]()
+    {
+        std::unique_lock<std::mutex> guard(decoder_lock);
+        while (!decoder_quit)
+        {
+            guard.unlock();
+            bool ok = fill();
+            guard.lock();
+
+            if (!ok)
+            {
+                log_cb(RETRO_LOG_ERROR, "Error reading music stream\n");
+                break;
+            }
+
+            // Timeout guards against a missed notification from render()
+            decoder_cv.wait_for(guard, std::chrono::milliseconds(20));
+        }
+    });
+#endif
+}
+
+void MusicStream::stop_decoder()
+{
+#ifdef USE_THREADS
+    if (decoder != NULL)
+    {
+        {
+            std::lock_guard<std::mutex> guard(decoder_lock);
+            decoder_quit = true;
+            decoder_cv.notify_all();
+        }
+        decoder->join();
+        delete decoder;
+        decoder = NULL;
+    }
+#endif
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+    Streaming Custom Music.
+
+    Plays custom music tracks without loading them into memory first.
+
+    The file is read in chunks through the libretro VFS and decoded into
+    a bounded ring of 16-bit stereo frames, at the file's own sample
+    rate. When threads are available this happens on a background
+    thread, so selecting a track never stalls the frame. Otherwise the
+    ring is topped up a chunk at a time as it drains.
+
+    The ring is resampled to the output rate as it is mixed. Tracks loop.
+
+    Supported formats: WAV (8/16/24/32-bit PCM, 32-bit float, mono or
+    stereo).
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef USE_THREADS
+#include <atomic>
+#endif
+
+struct RFILE;
+
+class MusicStream
+{
+public:
+    MusicStream();
+    ~MusicStream();
+
+    bool open(const char* path, uint32_t out_rate);
+    void close();
+    bool is_playing() { return file != NULL; }
+
+    // Resample the next block of stereo frames at the output rate into dst.
+    // Returns false if no track is playing.
+    bool render(int16_t* dst, uint32_t samples);
+
+    // Decode chunks into the ring until it is full. Returns false at a read error.
+    bool fill();
+
+private:
+    // Stereo frames held in the ring. Must be a power of 2.
+    static const uint32_t RING_FRAMES  = 1 << 15;
+
+    // Frames decoded per read
+    static const uint32_t CHUNK_FRAMES = 4096;
+
+    static const uint16_t FORMAT_PCM        = 0x0001;
+    static const uint16_t FORMAT_FLOAT      = 0x0003;
+    static const uint16_t FORMAT_EXTENSIBLE = 0xFFFE;
+
+    RFILE* file;
+
+    // Source format
+    uint16_t format;
+    uint16_t src_channels;
+    uint16_t src_bits;
+    uint16_t block_align;
+    uint32_t src_rate;
+
+    // Location of sample data within the file, and read position within it
+    int64_t data_start;
+    uint32_t data_size;
+    uint32_t data_pos;
+
+    // Raw chunk read from file
+    uint8_t* chunk;
+
+    // Decoded frames at the source rate
+    int16_t* ring;
+#ifdef USE_THREADS
+    std::atomic<uint32_t> head, tail;
+#else
+    uint32_t head, tail;
+#endif
+
+    // Resampler: 16.16 position between the previous and current source frames
+    uint32_t step;
+    uint32_t frac;
+    int16_t prev[2], cur[2];
+
+    bool parse_header();
+    bool decode_chunk();
+    void start_decoder();
+    void stop_decoder();
+};
@@ -9,20 +9,20 @@
 namespace cannonball
 {
 #ifdef COMPILE_SOUND_CODE
-    extern Audio audio;
+    extern ENGINE_GLOBAL Audio audio;
 #endif
 
     // Frame counter
-	extern int frame;
+	extern ENGINE_GLOBAL int frame;
 
     // Tick Logic. Used when running at non-standard > 30 fps
-    extern bool tick_frame;
+    extern ENGINE_GLOBAL bool tick_frame;
 
     // FPS Counter
-    extern int fps_counter;
+    extern ENGINE_GLOBAL int fps_counter;
 
     // Engine Master State
-    extern int state;
+    extern ENGINE_GLOBAL int state;
     
     enum
     {
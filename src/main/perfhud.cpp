@@ -0,0 +1,244 @@
+/***************************************************************************
+    Performance HUD.
+
+    An overlay showing where the time goes each frame. See perfhud.hpp
+    for details.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+
+#include "perfhud.hpp"
+#include "timing.hpp"
+#include "engine/osprites.hpp"
+#include "engine/audio/osoundint.hpp"
+
+bool perfhud::enabled = false;
+
+// Frame times shown in the graph, one column each
+static const int HISTORY = 128;
+static uint64_t history[HISTORY];
+static int history_pos;
+static uint64_t frame_budget;
+
+// The figures shown are averaged, and updated at this interval, so they can be read
+static const int AVERAGE_FRAMES = 30;
+static uint64_t section_acc[timing::SECTIONS];
+static uint64_t section_prev[timing::SECTIONS];
+static uint64_t frame_acc;
+static int acc_frames;
+
+static double section_ms[timing::SECTIONS];
+static double frame_ms, p99_ms, worst_ms;
+static uint16_t sprites;
+static uint8_t fm_active;
+static uint16_t pcm_active;
+
+// Subsystems, in the order shown, with their labels
+static const int SHOWN[] =
+{
+    timing::ENGINE, timing::ROAD, timing::TILES, timing::SPRITES, timing::PALETTE, timing::FM, timing::PCM
+};
+static const char* const LABELS[] = { "LOGIC", "ROAD", "TILE", "SPR", "PAL", "FM", "PCM" };
+
+// RGB565
+static const uint16_t WHITE  = 0xFFFF;
+static const uint16_t GREY   = 0x8410;
+static const uint16_t GREEN  = 0x07E0;
+static const uint16_t YELLOW = 0xFFE0;
+static const uint16_t RED    = 0xF800;
+
+// 3x5 font. A row per octal digit, top row first. The left pixel is the high bit.
+static const uint16_t FONT_DIGITS[10] =
+{
+    075557, 026227, 071747, 071717, 055711, 074717, 074757, 071111, 075757, 075717
+};
+
+static const uint16_t FONT_LETTERS[26] =
+{
+    025755, 065656, 034443, 065556, 074647, 074644, 034553, 055755, 072227, 011152, 055655, 044447, 057755,
+    065555, 025552, 065644, 025563, 065655, 034216, 072222, 055557, 055552, 055775, 055255, 055222, 071247
+};
+
+static uint16_t glyph(char c)
+{
+    if (c >= '0' && c <= '9') return FONT_DIGITS[c - '0'];
+    if (c >= 'A' && c <= 'Z') return FONT_LETTERS[c - 'A'];
+
+    switch (c)
+    {
+        case '.': return 000002;
+        case ':': return 002020;
+        case '-': return 000700;
+        case '/': return 011244;
+        default:  return 0;
+    }
+}
+
+void perfhud::reset()
+{
+    memset(history, 0, sizeof(history));
+    memset(section_acc, 0, sizeof(section_acc));
+    memcpy(section_prev, timing::total, sizeof(section_prev));
+    memset(section_ms, 0, sizeof(section_ms));
+    history_pos = 0;
+    frame_acc   = 0;
+    acc_frames  = 0;
+    frame_ms    = p99_ms = worst_ms = 0;
+}
+
+void perfhud::frame_done(uint64_t frame, uint64_t budget)
+{
+    history[history_pos] = frame;
+    history_pos  = (history_pos + 1) % HISTORY;
+    frame_budget = budget;
+
+    for (int i = 0; i < timing::SECTIONS; i++)
+    {
+        section_acc[i] += timing::total[i] - section_prev[i];
+        section_prev[i] = timing::total[i];
+    }
+    frame_acc += frame;
+
+    // Taken here, while the synthesis thread is idle
+    sprites    = osprites.sprite_count;
+    fm_active  = osoundint.ym  ? osoundint.ym->active_channels()  : 0;
+    pcm_active = osoundint.pcm ? osoundint.pcm->active_channels() : 0;
+
+    if (++acc_frames < AVERAGE_FRAMES)
+        return;
+
+    for (int i = 0; i < timing::SECTIONS; i++)
+    {
+        section_ms[i]  = (section_acc[i] / 1e6) / AVERAGE_FRAMES;
+        section_acc[i] = 0;
+    }
+    frame_ms   = (frame_acc / 1e6) / AVERAGE_FRAMES;
+    frame_acc  = 0;
+    acc_frames = 0;
+
+    uint64_t sorted[HISTORY];
+    memcpy(sorted, history, sizeof(sorted));
+    std::sort(sorted, sorted + HISTORY);
+    p99_ms   = sorted[(HISTORY * 99) / 100] / 1e6;
+    worst_ms = sorted[HISTORY - 1] / 1e6;
+}
+
+// ------------------------------------------------------------------------------------------------
+// Drawing. Everything is clipped to the frame.
+// ------------------------------------------------------------------------------------------------
+
+static uint16_t* pixels;
+static int width, height, scale;
+
+static void fill(int x, int y, int w, int h, uint16_t colour)
+{
+    const int x2 = std::min(x + w, width);
+    const int y2 = std::min(y + h, height);
+    for (int py = std::max(y, 0); py < y2; py++)
+        for (int px = std::max(x, 0); px < x2; px++)
+            pixels[(py * width) + px] = colour;
+}
+
+// Darken the picture behind the HUD, to keep the text readable
+static void shade(int x, int y, int w, int h)
+{
+    const int x2 = std::min(x + w, width);
+    const int y2 = std::min(y + h, height);
+    for (int py = std::max(y, 0); py < y2; py++)
+        for (int px = std::max(x, 0); px < x2; px++)
+            pixels[(py * width) + px] = (pixels[(py * width) + px] >> 2) & 0x39E7;
+}
+
+// Returns the x position following the text
+static int text(int x, int y, const char* str, uint16_t colour)
+{
+    for (; *str; str++)
+    {
+        const uint16_t g = glyph(*str);
+        for (int row = 0; row < 5; row++)
+        {
+            const int bits = (g >> (3 * (4 - row))) & 7;
+            for (int col = 0; col < 3; col++)
+            {
+                if (bits & (4 >> col))
+                    fill(x + (col * scale), y + (row * scale), scale, scale, colour);
+            }
+        }
+        x += 4 * scale;
+    }
+    return x;
+}
+
+// A lit or unlit box per channel
+static void channels(int x, int y, uint32_t active, int count)
+{
+    for (int i = 0; i < count; i++)
+        fill(x + (i * 4 * scale), y, 3 * scale, 5 * scale, (active >> i) & 1 ? GREEN : GREY);
+}
+
+static uint16_t frame_colour(uint64_t ns)
+{
+    if (ns <= frame_budget / 2) return GREEN;
+    if (ns <= frame_budget)     return YELLOW;
+    return RED;
+}
+
+void perfhud::draw(uint16_t* p, int w, int h)
+{
+    pixels = p;
+    width  = w;
+    height = h;
+    scale  = h >= 448 ? 2 : 1;
+
+    const int LINE    = 7 * scale;
+    const int GRAPH_H = 24 * scale;
+    const int x       = 4 * scale;
+    int y             = 4 * scale;
+
+    shade(x - (2 * scale), y - (2 * scale), 140 * scale, (6 * LINE) + GRAPH_H + (5 * scale));
+
+    char buf[48];
+    snprintf(buf, sizeof(buf), "FRAME %.2f P99 %.2f MAX %.2f", frame_ms, p99_ms, worst_ms);
+    text(x, y, buf, WHITE);
+    y += LINE;
+
+    // Subsystems, across two lines
+    int tx = x;
+    for (int i = 0; i < 7; i++)
+    {
+        if (i == 3)
+        {
+            tx = x;
+            y += LINE;
+        }
+        snprintf(buf, sizeof(buf), "%s %.2f ", LABELS[i], section_ms[SHOWN[i]]);
+        tx = text(tx, y, buf, WHITE);
+    }
+    y += LINE;
+
+    snprintf(buf, sizeof(buf), "SPRITES %u", (unsigned) sprites);
+    text(x, y, buf, WHITE);
+    y += LINE;
+
+    channels(text(x, y, "FM  ", WHITE), y, fm_active, 8);
+    y += LINE;
+
+    channels(text(x, y, "PCM ", WHITE), y, pcm_active, 16);
+    y += LINE;
+
+    // Frame times, oldest first. The full height is twice the budget, with the budget marked.
+    for (int i = 0; i < HISTORY; i++)
+    {
+        const uint64_t ns = history[(history_pos + i) % HISTORY];
+        int bar = frame_budget ? (int) ((ns * GRAPH_H) / (frame_budget * 2)) : 0;
+        if (bar > GRAPH_H)
+            bar = GRAPH_H;
+        fill(x + (i * scale), y + GRAPH_H - bar, scale, bar, frame_colour(ns));
+    }
+    fill(x, y + (GRAPH_H / 2), HISTORY * scale, scale, GREY);
+}
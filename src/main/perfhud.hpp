@@ -0,0 +1,32 @@
+/***************************************************************************
+    Performance HUD.
+
+    An overlay showing where the time goes each frame: The time taken by
+    each subsystem, a graph of recent frame times with the 99th percentile
+    and worst case, the number of sprites drawn and the channels playing
+    on each sound chip.
+
+    It is drawn over the finished picture, after the palette is resolved,
+    so the game's own video RAM is never touched.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace perfhud
+{
+    extern bool enabled;
+
+    void reset();
+
+    // Call once per frame, once its audio is complete.
+    // Frame: Time the core spent on the frame. Budget: Time available for each frame (Nanoseconds)
+    void frame_done(uint64_t frame, uint64_t budget);
+
+    // Draw the overlay over a frame of RGB565 pixels
+    void draw(uint16_t* pixels, int width, int height);
+}
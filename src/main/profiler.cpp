@@ -0,0 +1,154 @@
+/***************************************************************************
+    Routine Profiler.
+
+    Counts the calls to, and the time spent in, individual routines of the
+    ported game engine. See profiler.hpp for details.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include "profiler.hpp"
+
+#ifdef PROFILE_ROUTINES
+
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <streams/file_stream.h>
+
+#ifdef USE_THREADS
+#include <mutex>
+static std::mutex registry_lock;
+#endif
+
+// Length of one engine tick on the original hardware (Nanoseconds)
+static const double TICK_NS = 1e9 / 30.0;
+
+ENGINE_GLOBAL bool profiler::enabled = false;
+ENGINE_GLOBAL uint32_t profiler::ticks = 0;
+ENGINE_GLOBAL profiler::Scope* profiler::current = 0;
+
+// Every routine called so far, most recently registered first
+static profiler::Routine* routines = 0;
+
+profiler::Routine::Routine(const char* function, uint32_t adr)
+{
+    // "void OSprites::do_sprite(oentry*)" becomes "OSprites::do_sprite"
+    const char* end = strchr(function, '(');
+    if (end == NULL)
+        end = function + strlen(function);
+    const char* begin = end;
+    while (begin > function && begin[-1] != ' ')
+        begin--;
+
+    size_t len = std::min((size_t) (end - begin), sizeof(name) - 1);
+    memcpy(name, begin, len);
+    name[len] = 0;
+
+    this->adr = adr;
+    calls     = 0;
+    total     = 0;
+    self      = 0;
+
+#ifdef USE_THREADS
+    std::lock_guard<std::mutex> guard(registry_lock);
+#endif
+    next     = routines;
+    routines = this;
+}
+
+void profiler::start()
+{
+    {
+#ifdef USE_THREADS
+        std::lock_guard<std::mutex> guard(registry_lock);
+#endif
+        for (Routine* r = routines; r != NULL; r = r->next)
+            r->calls = r->total = r->self = 0;
+    }
+
+    ticks   = 0;
+    current = 0;
+    enabled = true;
+}
+
+void profiler::stop()
+{
+    enabled = false;
+}
+
+static bool by_self_time(const profiler::Routine* a, const profiler::Routine* b)
+{
+    return a->self > b->self;
+}
+
+static std::vector<const profiler::Routine*> sorted_routines()
+{
+    std::vector<const profiler::Routine*> list;
+    {
+#ifdef USE_THREADS
+        std::lock_guard<std::mutex> guard(registry_lock);
+#endif
+        for (const profiler::Routine* r = routines; r != NULL; r = r->next)
+        {
+            if (r->calls)
+                list.push_back(r);
+        }
+    }
+    std::stable_sort(list.begin(), list.end(), by_self_time);
+    return list;
+}
+
+static bool write_file(const char* filename, const std::string& out)
+{
+    return filestream_write_file(filename, out.c_str(), out.size());
+}
+
+bool profiler::dump_csv(const char* filename)
+{
+    std::vector<const Routine*> list = sorted_routines();
+    const double t = ticks ? ticks : 1;
+
+    std::string out = "routine,address,calls,calls_per_tick,total_ms,self_ms,self_us_per_tick,tick_budget_pct\n";
+    char line[256];
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const Routine* r = list[i];
+        snprintf(line, sizeof(line), "%s,0x%X,%llu,%.2f,%.3f,%.3f,%.3f,%.3f\n",
+                 r->name, r->adr, (unsigned long long) r->calls, r->calls / t,
+                 r->total / 1e6, r->self / 1e6, (r->self / 1e3) / t, (r->self / t) * 100.0 / TICK_NS);
+        out += line;
+    }
+    return write_file(filename, out);
+}
+
+bool profiler::dump_json(const char* filename)
+{
+    std::vector<const Routine*> list = sorted_routines();
+    const double t = ticks ? ticks : 1;
+
+    std::string out;
+    char line[320];
+    snprintf(line, sizeof(line), "{\n  \"ticks\": %u,\n  \"tick_budget_ms\": %.3f,\n  \"routines\": [\n",
+             ticks, TICK_NS / 1e6);
+    out += line;
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const Routine* r = list[i];
+        snprintf(line, sizeof(line),
+                 "    { \"routine\": \"%s\", \"address\": \"0x%X\", \"calls\": %llu, \"calls_per_tick\": %.2f, "
+                 "\"total_ms\": %.3f, \"self_ms\": %.3f, \"self_us_per_tick\": %.3f, \"tick_budget_pct\": %.3f }%s\n",
+                 r->name, r->adr, (unsigned long long) r->calls, r->calls / t,
+                 r->total / 1e6, r->self / 1e6, (r->self / 1e3) / t, (r->self / t) * 100.0 / TICK_NS,
+                 i + 1 < list.size() ? "," : "");
+        out += line;
+    }
+    out += "  ]\n}\n";
+    return write_file(filename, out);
+}
+
+#endif
@@ -0,0 +1,117 @@
+/***************************************************************************
+    Routine Profiler.
+
+    Counts the calls to, and the time spent in, individual routines of the
+    ported game engine. Each profiled routine is tagged with its C++ name
+    and the address of the original 68000 routine it was ported from, so
+    the cost can be compared against the original hardware budget of one
+    engine tick (1/30th of a second).
+
+    Only built when compiled with PROFILE_ROUTINES (make PROFILE_ROUTINES=1).
+    Otherwise PROFILE_ROUTINE() expands to nothing.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "globals.hpp"
+#include "timing.hpp"
+
+#ifdef PROFILE_ROUTINES
+
+#if defined(_MSC_VER)
+#define PROFILE_FUNCTION __FUNCTION__
+#else
+#define PROFILE_FUNCTION __PRETTY_FUNCTION__
+#endif
+
+// Place at the top of a routine, with the address of the original routine
+#define PROFILE_ROUTINE(adr) \
+    static profiler::Routine profile_routine(PROFILE_FUNCTION, adr); \
+    profiler::Scope profile_scope(profile_routine)
+
+// Place where the engine ticks, to report the cost of each routine per tick
+#define PROFILE_TICK() \
+    do { if (profiler::enabled) profiler::ticks++; } while (0)
+
+namespace profiler
+{
+    // Totals for a single routine. Registered the first time the routine is called.
+    struct Routine
+    {
+        char name[64];  // C++ name, without the return and parameter types
+        uint32_t adr;   // Address of the original routine
+        uint64_t calls;
+        uint64_t total; // Time spent in the routine (Nanoseconds)
+        uint64_t self;  // Time spent in the routine, less that in profiled routines it calls
+        Routine* next;
+
+        Routine(const char* function, uint32_t adr);
+    };
+
+    // Profiling covers the engine on the thread that started it
+    extern ENGINE_GLOBAL bool enabled;
+
+    // Engine ticks run while profiling
+    extern ENGINE_GLOBAL uint32_t ticks;
+
+    class Scope;
+    extern ENGINE_GLOBAL Scope* current;
+
+    // Clear the totals, and begin profiling the calling thread's engine
+    void start();
+    void stop();
+
+    // Write the totals, most expensive first, to a file
+    bool dump_csv(const char* filename);
+    bool dump_json(const char* filename);
+
+    class Scope
+    {
+    public:
+        Scope(Routine& r)
+        {
+            if (!enabled)
+            {
+                routine = 0;
+                return;
+            }
+
+            routine = &r;
+            parent  = current;
+            current = this;
+            child   = 0;
+            start   = timing::now();
+        }
+
+        ~Scope()
+        {
+            if (!routine)
+                return;
+
+            const uint64_t elapsed = timing::now() - start;
+            routine->calls++;
+            routine->total += elapsed;
+            routine->self  += elapsed - child;
+            if (parent)
+                parent->child += elapsed;
+            current = parent;
+        }
+
+    private:
+        Routine* routine;
+        Scope* parent;
+        uint64_t child;
+        uint64_t start;
+    };
+}
+
+#else
+
+#define PROFILE_ROUTINE(adr)
+#define PROFILE_TICK()
+
+#endif
@@ -0,0 +1,314 @@
+/***************************************************************************
+    Rewind Buffer.
+
+    Keeps a history of engine snapshots, so play can be wound back.
+
+    A snapshot is taken every few ticks. Each is stored as the difference
+    from the one before it: the bytes that changed are XORed with their
+    previous value and the unchanged runs between them are skipped. Most
+    of the engine state (tile RAM in particular) is unchanged from one
+    tick to the next, so a snapshot typically takes a few KB.
+
+    Deltas are held in a ring of fixed size. When it is full, the oldest
+    snapshots are dropped.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <string.h>
+#include "rewind.hpp"
+#include "savestate.hpp"
+
+RewindBuffer rewind_buffer;
+
+// Unchanged runs shorter than this are stored with the changed bytes around them,
+// as that costs less than starting a new run.
+static const uint32_t MIN_GAP = 4;
+
+static inline uint32_t put_varint(uint8_t* out, uint32_t v)
+{
+    uint32_t n = 0;
+    while (v >= 0x80)
+    {
+        out[n++] = (uint8_t) (v | 0x80);
+        v >>= 7;
+    }
+    out[n++] = (uint8_t) v;
+    return n;
+}
+
+static inline uint32_t get_varint(const uint8_t* in, uint32_t* pos, uint32_t length)
+{
+    uint32_t v = 0;
+    for (uint32_t shift = 0; *pos < length && shift < 32; shift += 7)
+    {
+        const uint8_t b = in[(*pos)++];
+        v |= (b & 0x7F) << shift;
+        if ((b & 0x80) == 0)
+            break;
+    }
+    return v;
+}
+
+RewindBuffer::RewindBuffer()
+{
+    buffer      = NULL;
+    current     = NULL;
+    next        = NULL;
+    packed      = NULL;
+    buffer_size = 0;
+    state_size  = 0;
+    interval    = 1;
+    clear();
+}
+
+RewindBuffer::~RewindBuffer()
+{
+    free_buffers();
+}
+
+void RewindBuffer::init(uint32_t buffer_size, uint32_t interval)
+{
+    if (buffer == NULL || buffer_size != this->buffer_size)
+    {
+        delete[] buffer;
+        buffer = new uint8_t[buffer_size];
+        this->buffer_size = buffer_size;
+    }
+
+    this->interval = interval ? interval : 1;
+    clear();
+}
+
+void RewindBuffer::disable()
+{
+    free_buffers();
+    clear();
+}
+
+void RewindBuffer::free_buffers()
+{
+    delete[] buffer;
+    delete[] current;
+    delete[] next;
+    delete[] packed;
+    buffer     = NULL;
+    current    = NULL;
+    next       = NULL;
+    packed     = NULL;
+    state_size = 0;
+}
+
+void RewindBuffer::clear()
+{
+    first       = 0;
+    records     = 0;
+    counter     = 0;
+    has_current = false;
+    current_tick = 0;
+    at_current  = false;
+}
+
+void RewindBuffer::capture(uint32_t tick)
+{
+    if (buffer == NULL)
+        return;
+
+    at_current = false;
+
+    if (has_current && ++counter < interval)
+        return;
+
+    counter = 0;
+
+    // Snapshot buffers are sized on first use, once the engine is fully initialised
+    if (state_size != savestate::size())
+    {
+        delete[] current;
+        delete[] next;
+        delete[] packed;
+        state_size = savestate::size();
+        current    = new uint8_t[state_size];
+        next       = new uint8_t[state_size];
+        packed     = new uint8_t[state_size + (state_size >> 1) + 16]; // Worst case for pack_delta()
+        clear();
+    }
+
+    if (!savestate::save(next, state_size))
+        return;
+
+    if (has_current)
+        push(packed, pack_delta(current, next, packed), current_tick);
+
+    uint8_t* swap = current;
+    current       = next;
+    next          = swap;
+    current_tick  = tick;
+    has_current   = true;
+    at_current    = true;
+}
+
+void RewindBuffer::state_loaded(uint32_t tick)
+{
+    if (!has_current)
+        return;
+
+    // Undo deltas until the newest snapshot is no later than the state loaded
+    while (current_tick > tick)
+    {
+        if (records == 0)
+        {
+            clear();
+            return;
+        }
+
+        const record_t& r = record[(first + records - 1) % MAX_RECORDS];
+        unpack_delta(buffer + r.offset, r.length, current);
+        current_tick = r.tick;
+        records--;
+    }
+
+    // Continue the interval from the newest snapshot
+    const uint32_t since = tick - current_tick;
+    at_current = false;
+    counter    = since < interval ? since : interval - 1;
+}
+
+bool RewindBuffer::step_back()
+{
+    if (!has_current)
+        return false;
+
+    // The game has moved on since the newest snapshot: Return to it first
+    if (!at_current)
+    {
+        at_current = true;
+        counter    = 0;
+        return savestate::load(current, state_size);
+    }
+
+    if (records == 0)
+        return false;
+
+    // Undo the newest delta, to recover the snapshot before it
+    const record_t& r = record[(first + records - 1) % MAX_RECORDS];
+    unpack_delta(buffer + r.offset, r.length, current);
+    current_tick = r.tick;
+    records--;
+    counter = 0;
+
+    return savestate::load(current, state_size);
+}
+
+// Encode the difference between two snapshots as a series of:
+// [Unchanged Bytes To Skip: Varint] [Changed Bytes: Varint] [Changed Bytes XOR Previous Value]
+uint32_t RewindBuffer::pack_delta(const uint8_t* a, const uint8_t* b, uint8_t* out)
+{
+    const uint32_t n = (uint32_t) state_size;
+    uint32_t i = 0;
+    uint32_t o = 0;
+
+    while (i < n)
+    {
+        const uint32_t start = i;
+        while (i < n && a[i] == b[i])
+            i++;
+
+        if (i == n)
+            break;
+
+        const uint32_t lit_start = i;
+        uint32_t lit_end = i;
+
+        while (i < n)
+        {
+            if (a[i] != b[i])
+                lit_end = ++i;
+            else if (i - lit_end >= MIN_GAP)
+                break;
+            else
+                i++;
+        }
+
+        i = lit_end;
+        o += put_varint(out + o, lit_start - start);
+        o += put_varint(out + o, lit_end - lit_start);
+
+        for (uint32_t j = lit_start; j < lit_end; j++)
+            out[o++] = a[j] ^ b[j];
+    }
+
+    return o;
+}
+
+void RewindBuffer::unpack_delta(const uint8_t* in, uint32_t length, uint8_t* dst)
+{
+    uint32_t p   = 0;
+    uint32_t pos = 0;
+
+    while (p < length)
+    {
+        pos += get_varint(in, &p, length);
+        uint32_t count = get_varint(in, &p, length);
+
+        if (pos + count > state_size || p + count > length)
+            return;
+
+        for (uint32_t j = 0; j < count; j++)
+            dst[pos++] ^= in[p++];
+    }
+}
+
+// Append a delta to the ring, dropping the oldest to make room
+void RewindBuffer::push(const uint8_t* data, uint32_t length, uint32_t tick)
+{
+    // Too large to ever fit: History is broken, so start again from here
+    if (length > buffer_size)
+    {
+        records = 0;
+        return;
+    }
+
+    uint32_t offset = 0;
+
+    if (records > 0)
+    {
+        const record_t& last = record[(first + records - 1) % MAX_RECORDS];
+        const uint32_t end = last.offset + last.length;
+
+        if (end + length <= buffer_size)
+        {
+            offset = end;
+        }
+        // Wrap to the start. Deltas left past the end of the newest are the oldest of all.
+        else
+        {
+            while (records > 0 && record[first].offset >= end)
+            {
+                first = (first + 1) % MAX_RECORDS;
+                records--;
+            }
+        }
+    }
+
+    while (records > 0)
+    {
+        const record_t& old = record[first];
+        const bool overlap = old.offset < offset + length && offset < old.offset + old.length;
+
+        if (!overlap && records < MAX_RECORDS)
+            break;
+
+        first = (first + 1) % MAX_RECORDS;
+        records--;
+    }
+
+    memcpy(buffer + offset, data, length);
+
+    record_t& r = record[(first + records) % MAX_RECORDS];
+    r.offset = offset;
+    r.length = length;
+    r.tick   = tick;
+    records++;
+}
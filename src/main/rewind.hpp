@@ -0,0 +1,99 @@
+/***************************************************************************
+    Rewind Buffer.
+
+    Keeps a history of engine snapshots, so play can be wound back.
+
+    A snapshot is taken every few ticks. Each is stored as the difference
+    from the one before it: the bytes that changed are XORed with their
+    previous value and the unchanged runs between them are skipped. Most
+    of the engine state (tile RAM in particular) is unchanged from one
+    tick to the next, so a snapshot typically takes a few KB.
+
+    Deltas are held in a ring of fixed size. When it is full, the oldest
+    snapshots are dropped.
+
+    Each snapshot is tagged with the engine tick it was taken on. When the
+    frontend loads a state (run-ahead, netplay rollback or a user load),
+    snapshots newer than the loaded tick are dropped, so frames that were
+    rolled back never appear in the history.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class RewindBuffer
+{
+public:
+    RewindBuffer();
+    ~RewindBuffer();
+
+    // Allocate a buffer of the given size, taking a snapshot every interval ticks
+    void init(uint32_t buffer_size, uint32_t interval);
+    void disable();
+    void clear();
+
+    bool is_enabled() { return buffer != NULL; }
+
+    // Call after each engine tick, with the tick counter of the engine
+    void capture(uint32_t tick);
+
+    // Call when a state has been loaded. Drops snapshots taken after the given tick.
+    void state_loaded(uint32_t tick);
+
+    // Restore the previous snapshot. Returns false when there is no more history.
+    bool step_back();
+
+    // Number of snapshots held
+    uint32_t count() { return records; }
+
+private:
+    // Maximum number of snapshots held, regardless of buffer size
+    static const uint32_t MAX_RECORDS = 8192;
+
+    struct record_t
+    {
+        uint32_t offset;
+        uint32_t length;
+        uint32_t tick;   // Tick of the snapshot the delta recovers
+    };
+
+    // Ring of compressed deltas
+    uint8_t* buffer;
+    uint32_t buffer_size;
+
+    // Position in the ring of each delta, oldest first
+    record_t record[MAX_RECORDS];
+    uint32_t first;
+    uint32_t records;
+
+    // The newest snapshot, in full, which deltas are applied to when stepping back
+    uint8_t* current;
+
+    // Snapshot being taken
+    uint8_t* next;
+
+    // Delta being compressed
+    uint8_t* packed;
+
+    size_t state_size;
+    bool has_current;
+    uint32_t current_tick;
+
+    // The engine is at the newest snapshot, so stepping back should move to the one before
+    bool at_current;
+
+    uint32_t interval;
+    uint32_t counter;
+
+    uint32_t pack_delta(const uint8_t* a, const uint8_t* b, uint8_t* out);
+    void unpack_delta(const uint8_t* in, uint32_t length, uint8_t* dst);
+    void push(const uint8_t* data, uint32_t length, uint32_t tick);
+    void free_buffers();
+};
+
+extern RewindBuffer rewind_buffer;
@@ -30,6 +30,8 @@ int64_t rfread(void* buffer,
 RomLoader::RomLoader()
 {
     loaded = false;
+    rom16  = NULL;
+    rom32  = NULL;
 }
 
 RomLoader::~RomLoader()
@@ -40,11 +42,39 @@ void RomLoader::init(const uint32_t length)
 {
     this->length = length;
     rom = new uint8_t[length];
+    free_native();
 }
 
 void RomLoader::unload(void)
 {
     delete[] rom;
+    free_native();
+}
+
+void RomLoader::build_native(void)
+{
+    // Engine contexts may be reading the copies, so they are only freed with the rom itself
+    if (rom16 != NULL)
+        return;
+
+    const uint32_t words = length >> 1;
+    rom16 = new uint16_t[words];
+    rom32 = new uint32_t[words];
+
+    for (uint32_t i = 0; i < words; i++)
+        rom16[i] = read16(i << 1);
+
+    // Longs that run past the end of the rom are padded with zero
+    for (uint32_t i = 0; i < words; i++)
+        rom32[i] = ((uint32_t) rom16[i] << 16) | (i + 1 < words ? rom16[i + 1] : 0);
+}
+
+void RomLoader::free_native(void)
+{
+    delete[] rom16;
+    delete[] rom32;
+    rom16 = NULL;
+    rom32 = NULL;
 }
 
 int RomLoader::load(const char* filename, const int offset, const int length, const uint32_t expected_crc, const uint8_t interleave)
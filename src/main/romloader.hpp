@@ -18,6 +18,11 @@ public:
 
     uint8_t* rom;
 
+    // Native endian copies of the rom, for the 68000 code's word and long reads.
+    // Entry per word aligned address. NULL until built by build_native().
+    uint16_t* rom16;
+    uint32_t* rom32;
+
     // Size of rom
     uint32_t length;
 
@@ -31,6 +36,10 @@ public:
     int load_binary(const char* filename);
     void unload(void);
 
+    // Build the native endian copies. Call once the rom has loaded. Does nothing if already built.
+    void build_native(void);
+    void free_native(void);
+
     // ----------------------------------------------------------------------------
     // Used by translated 68000 Code
     // ----------------------------------------------------------------------------
@@ -69,6 +78,37 @@ public:
         return rom[addr];
     }
 
+    // ----------------------------------------------------------------------------
+    // Native endian reads for translated 68000 Code, once build_native() has run.
+    //
+    // The 68000 only reads words and longs from even addresses, so these are a
+    // single load. Odd addresses fall back to assembling bytes.
+    // ----------------------------------------------------------------------------
+
+    inline uint32_t read32n(uint32_t* addr)
+    {
+        uint32_t data = read32n(*addr);
+        *addr += 4;
+        return data;
+    }
+
+    inline uint16_t read16n(uint32_t* addr)
+    {
+        uint16_t data = read16n(*addr);
+        *addr += 2;
+        return data;
+    }
+
+    inline uint32_t read32n(uint32_t addr)
+    {
+        return (addr & 1) ? read32(addr) : rom32[addr >> 1];
+    }
+
+    inline uint16_t read16n(uint32_t addr)
+    {
+        return (addr & 1) ? read16(addr) : rom16[addr >> 1];
+    }
+
     // ----------------------------------------------------------------------------
     // Used by translated Z80 Code
     // Note that the endian is reversed compared with the 68000 code.
@@ -84,6 +84,13 @@ bool Roms::load_revb_roms()
     status += pcm.load("opr-10189.70", 0x40000, 0x08000, 0x01366b54);
     status += pcm.load("opr-10188.71", 0x50000, 0x08000, 0xbad30ad9);
 
+    // Native endian copies of the program roms, for the engine
+    if (status == 0)
+    {
+        rom0.build_native();
+        rom1.build_native();
+    }
+
     // If status has been incremented, a rom has failed to load.
     return status == 0;
 }
@@ -111,6 +118,14 @@ bool Roms::load_japanese_roms()
     jap_rom_status += j_rom1.load("epr-10329.58", 0x00001, 0x10000, 0xfe0fa5e2, RomLoader::INTERLEAVE2);
     jap_rom_status += j_rom1.load("epr-10328.75", 0x20000, 0x10000, 0x3c0e9a7f, RomLoader::INTERLEAVE2);
     jap_rom_status += j_rom1.load("epr-10330.57", 0x20001, 0x10000, 0x59786e99, RomLoader::INTERLEAVE2);
+
+    // Built the first time only: The roms are reloaded for every game, but their contents don't change
+    if (jap_rom_status == 0)
+    {
+        j_rom0.build_native();
+        j_rom1.build_native();
+    }
+
     // If status has been incremented, a rom has failed to load.
     return jap_rom_status == 0;
 }
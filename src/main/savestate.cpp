@@ -0,0 +1,229 @@
+/***************************************************************************
+    Save States.
+
+    The complete engine state is serialised to a fixed size block, for
+    use by the frontend's save states, rewind, run-ahead and netplay.
+
+    The state is mostly the engine objects themselves, copied whole.
+    Pointers held by those objects are either left alone (references to
+    ROM data and other fixed allocations) or stored as indices.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include "main.hpp"
+#include "savestate.hpp"
+#include "inputlog.hpp"
+#include "trackloader.hpp"
+#include "engine/oanimseq.hpp"
+#include "engine/oattractai.hpp"
+#include "engine/obonus.hpp"
+#include "engine/ocrash.hpp"
+#include "engine/oferrari.hpp"
+#include "engine/ohiscore.hpp"
+#include "engine/ohud.hpp"
+#include "engine/oinputs.hpp"
+#include "engine/olevelobjs.hpp"
+#include "engine/ologo.hpp"
+#include "engine/omap.hpp"
+#include "engine/omusic.hpp"
+#include "engine/ooutputs.hpp"
+#include "engine/opalette.hpp"
+#include "engine/osmoke.hpp"
+#include "engine/ostats.hpp"
+#include "engine/otiles.hpp"
+#include "engine/otraffic.hpp"
+#include "engine/outils.hpp"
+#include "engine/outrun.hpp"
+
+extern bool pause_engine;
+
+struct state_header_t
+{
+    uint8_t  magic[4];
+    uint32_t version;
+    uint32_t size;
+};
+
+static const uint8_t MAGIC[4] = { 'C', 'B', 'S', 'S' };
+
+static void sync_anim(StateBuf& state, oanimsprite& anim)
+{
+    osprites.sync_entry(state, anim.sprite);
+}
+
+static void sync_engine(StateBuf& state)
+{
+    // Master state. The menu isn't part of the state, so restart it when a
+    // state saved from the menu is loaded during the game.
+    int engine_state = cannonball::state;
+    state.sync(engine_state);
+    state.sync(cannonball::frame);
+    state.sync(cannonball::tick_frame);
+    state.sync(pause_engine);
+
+    if (state.loading())
+    {
+        if (engine_state == cannonball::STATE_MENU && cannonball::state != cannonball::STATE_MENU)
+            engine_state = cannonball::STATE_INIT_MENU;
+        cannonball::state = engine_state;
+    }
+
+    uint32_t seed = outils::get_random_seed();
+    state.sync(seed);
+    if (state.loading())
+        outils::set_random_seed(seed);
+
+    uint32_t entropy = outils::get_entropy();
+    state.sync(entropy);
+    if (state.loading())
+        outils::set_entropy(entropy);
+
+    // Objects without pointers, or whose pointers are fixed up below
+    OOutputs* outputs  = outrun.outputs;
+    const uint8_t* lap_ms = ostats.lap_ms;
+    const sprite_frame_t* sprite_frames = osprites.frames;
+
+    state.sync(outrun);
+    state.sync(*outputs);
+    state.sync(oroad);
+    state.sync(osprites);
+    otraffic.sync_state(state);
+    state.sync(oferrari);
+    state.sync(ocrash);
+    state.sync(oinitengine);
+    state.sync(ostats);
+    state.sync(otiles);
+    state.sync(opalette);
+    state.sync(ohud);
+    state.sync(olevelobjs);
+    state.sync(obonus);
+    state.sync(oanimseq);
+    state.sync(oattractai);
+    state.sync(ohiscore);
+    state.sync(oinputs);
+    state.sync(ologo);
+    state.sync(omap);
+    state.sync(osmoke);
+    omusic.sync_state(state);
+
+    outrun.outputs   = outputs;
+    ostats.lap_ms    = lap_ms;
+    osprites.frames  = sprite_frames;
+
+    // Sprite entries referenced by other objects
+    osprites.sync_entry(state, oferrari.spr_ferrari);
+    osprites.sync_entry(state, oferrari.spr_pass1);
+    osprites.sync_entry(state, oferrari.spr_pass2);
+    osprites.sync_entry(state, oferrari.spr_shadow);
+
+    osprites.sync_entry(state, ocrash.spr_ferrari);
+    osprites.sync_entry(state, ocrash.spr_shadow);
+    osprites.sync_entry(state, ocrash.spr_pass1);
+    osprites.sync_entry(state, ocrash.spr_pass1s);
+    osprites.sync_entry(state, ocrash.spr_pass2);
+    osprites.sync_entry(state, ocrash.spr_pass2s);
+
+    sync_anim(state, oanimseq.anim_flag);
+    sync_anim(state, oanimseq.anim_ferrari);
+    sync_anim(state, oanimseq.anim_pass1);
+    sync_anim(state, oanimseq.anim_pass2);
+    sync_anim(state, oanimseq.anim_obj1);
+    sync_anim(state, oanimseq.anim_obj2);
+    sync_anim(state, oanimseq.anim_obj3);
+    sync_anim(state, oanimseq.anim_obj4);
+    sync_anim(state, oanimseq.anim_obj5);
+    sync_anim(state, oanimseq.anim_obj6);
+    sync_anim(state, oanimseq.anim_obj7);
+    sync_anim(state, oanimseq.anim_obj8);
+
+    trackloader.sync_state(state);
+    video.sync_state(state);
+    osoundint.sync_state(state);
+    inputlog.sync_state(state);
+}
+
+static bool sync_all(StateBuf& state)
+{
+    state_header_t header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = savestate::VERSION;
+    header.size    = 0;
+
+    if (!state.loading())
+        header.size = (uint32_t) savestate::size();
+
+    // Check the header before touching any engine state
+    state.sync(header);
+
+    if (state.loading() &&
+        (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+         header.version != savestate::VERSION ||
+         header.size != savestate::size()))
+        return false;
+
+    sync_engine(state);
+
+    return !state.overflow();
+}
+
+uint32_t savestate::hash()
+{
+    StateHash hash;
+
+    // Settings read during the tick
+    hash.add32(config.fps);
+    hash.add32(config.tick_fps);
+
+    hash.add32(outils::get_random_seed());
+    hash.add32(outils::get_entropy());
+
+    hash.add8(outrun.cannonball_mode);
+    hash.add8(outrun.game_state);
+    hash.add32(outrun.tick_counter);
+    hash.add32(outrun.vint_counter);
+
+    hash.add32(ostats.score);
+    hash.add16(ostats.time_counter);
+    hash.add8(ostats.cur_stage);
+
+    hash.add16(oinitengine.car_x_pos);
+    hash.add32(oinitengine.car_increment);
+    hash.add32(oroad.road_pos);
+    hash.add32(oroad.road_width);
+    hash.add8(oferrari.car_state);
+    hash.add32(oferrari.revs);
+
+    // Everything the engine has drawn
+    video.hash_state(hash);
+
+    return hash.value();
+}
+
+// Fixed for a given build once the core is loaded. Measuring is cheap, as nothing is copied.
+size_t savestate::size()
+{
+    StateBuf state(StateBuf::MEASURE);
+    state.skip(sizeof(state_header_t));
+    sync_engine(state);
+    return state.size();
+}
+
+bool savestate::save(void* data, size_t size)
+{
+    if (size < savestate::size())
+        return false;
+
+    StateBuf state(StateBuf::SAVE, (uint8_t*) data, size);
+    return sync_all(state);
+}
+
+bool savestate::load(const void* data, size_t size)
+{
+    if (size < savestate::size())
+        return false;
+
+    StateBuf state(StateBuf::LOAD, (uint8_t*) data, size);
+    return sync_all(state);
+}
@@ -0,0 +1,139 @@
+/***************************************************************************
+    Save States.
+
+    The complete engine state is serialised to a fixed size block, for
+    use by the frontend's save states, rewind, run-ahead and netplay.
+
+    The state is mostly the engine objects themselves, copied whole.
+    Pointers held by those objects are either left alone (references to
+    ROM data and other fixed allocations) or stored as indices.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Reads or writes consecutive blocks of state.
+//
+// The same sync_state() code measures, saves and loads a state, so the
+// three can never disagree about the layout.
+class StateBuf
+{
+public:
+    enum
+    {
+        MEASURE,
+        SAVE,
+        LOAD,
+    };
+
+    StateBuf(int mode, uint8_t* data = NULL, size_t length = 0)
+    {
+        this->mode   = mode;
+        this->data   = data;
+        this->length = length;
+        pos          = 0;
+    }
+
+    bool loading() const { return mode == LOAD; }
+    bool saving()  const { return mode == SAVE; }
+
+    // Bytes processed so far. Greater than the buffer length on overflow.
+    size_t size() const  { return pos; }
+    bool overflow() const { return mode != MEASURE && pos > length; }
+
+    void sync(void* p, size_t len)
+    {
+        if (mode != MEASURE && pos + len <= length)
+        {
+            if (mode == SAVE)
+                memcpy(data + pos, p, len);
+            else
+                memcpy(p, data + pos, len);
+        }
+        pos += len;
+    }
+
+    template<typename T> void sync(T& v)
+    {
+        sync(&v, sizeof(T));
+    }
+
+    // Reserve space for data that isn't present, so the state size stays fixed
+    void skip(size_t len)
+    {
+        if (mode == SAVE && pos + len <= length)
+            memset(data + pos, 0, len);
+        pos += len;
+    }
+
+private:
+    int mode;
+    uint8_t* data;
+    size_t length;
+    size_t pos;
+};
+
+// Hash of engine values (FNV-1a).
+//
+// Values are added one at a time, least significant byte first, rather than
+// as structs in memory. So the hash doesn't depend on the byte order or
+// struct layout of the platform, and matching runs on different platforms
+// produce the same hash.
+class StateHash
+{
+public:
+    StateHash() { h = 2166136261u; }
+
+    uint32_t value() const { return h; }
+
+    void add8(uint8_t v)
+    {
+        h = (h ^ v) * 16777619u;
+    }
+
+    void add16(uint16_t v)
+    {
+        add8(v & 0xFF);
+        add8(v >> 8);
+    }
+
+    void add32(uint32_t v)
+    {
+        add16(v & 0xFFFF);
+        add16(v >> 16);
+    }
+
+    void add_bytes(const uint8_t* p, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+            add8(p[i]);
+    }
+
+    void add_words(const uint16_t* p, size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+            add16(p[i]);
+    }
+
+private:
+    uint32_t h;
+};
+
+namespace savestate
+{
+    // Bump when the layout of the state changes
+    const uint32_t VERSION = 8;
+
+    size_t size();
+    bool save(void* data, size_t size);
+    bool load(const void* data, size_t size);
+
+    // Hash of the key engine values and video hardware, for checking runs match tick for tick
+    uint32_t hash();
+}
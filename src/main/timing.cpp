@@ -0,0 +1,52 @@
+/***************************************************************************
+    Subsystem Timing.
+
+    Accumulates the time spent in each major part of the frame: The engine
+    tick, each layer of the video hardware and each sound chip.
+
+    Timing is disabled unless requested (by the benchmark runner), in which
+    case each timed section costs a pair of clock reads. Each section is
+    also recorded as a phase of the frame trace, when capturing (see trace.hpp).
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <string.h>
+#include "timing.hpp"
+
+#if __cplusplus >= 201103L
+#include <chrono>
+#else
+#include <time.h>
+#endif
+
+const char* const timing::NAMES[timing::SECTIONS] =
+{
+    "engine",
+    "road",
+    "tiles",
+    "sprites",
+    "palette",
+    "fm",
+    "pcm",
+};
+
+bool timing::enabled = false;
+uint64_t timing::total[timing::SECTIONS];
+
+uint64_t timing::now()
+{
+#if __cplusplus >= 201103L
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+    // Processor time only, at a coarser resolution, on older compilers
+    return (uint64_t) clock() * (1000000000 / CLOCKS_PER_SEC);
+#endif
+}
+
+void timing::reset()
+{
+    memset(total, 0, sizeof(total));
+}
@@ -0,0 +1,66 @@
+/***************************************************************************
+    Subsystem Timing.
+
+    Accumulates the time spent in each major part of the frame: The engine
+    tick, each layer of the video hardware and each sound chip.
+
+    Timing is disabled unless requested (by the benchmark runner), in which
+    case each timed section costs a pair of clock reads. Each section is
+    also recorded as a phase of the frame trace, when capturing (see trace.hpp).
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include "trace.hpp"
+
+namespace timing
+{
+    enum
+    {
+        ENGINE,  // Game logic for one tick
+        ROAD,    // Road layer rendering
+        TILES,   // Tile and text layer rendering
+        SPRITES, // Sprite layer rendering
+        PALETTE, // Resolving palette indices to output colours
+        FM,      // YM2151 synthesis
+        PCM,     // SegaPCM synthesis
+        SECTIONS
+    };
+
+    extern const char* const NAMES[SECTIONS];
+
+    extern bool enabled;
+
+    // Total time spent in each section since the last reset (Nanoseconds)
+    extern uint64_t total[SECTIONS];
+
+    uint64_t now();
+    void reset();
+
+    // Adds the time from construction to destruction to a section
+    class Scope
+    {
+    public:
+        Scope(int section)
+        {
+            this->section = section;
+            start = (enabled || trace::enabled) ? now() : 0;
+        }
+
+        ~Scope()
+        {
+            if (enabled)
+                total[section] += now() - start;
+            if (trace::enabled && start)
+                trace::record(NAMES[section], start);
+        }
+
+    private:
+        int section;
+        uint64_t start;
+    };
+}
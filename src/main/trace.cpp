@@ -0,0 +1,266 @@
+/***************************************************************************
+    Frame Tracing.
+
+    Records the start and duration of each phase of a frame to a trace
+    file, in the Chrome trace event format. See trace.hpp for details.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#include <stdio.h>
+#include <string>
+
+#include <streams/file_stream.h>
+
+#include "trace.hpp"
+#include "timing.hpp"
+
+#ifdef USE_THREADS
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#endif
+
+bool trace::enabled = false;
+
+struct event_t
+{
+    const char* name;
+    uint64_t start;     // Nanoseconds
+    uint64_t duration;  // Nanoseconds
+    uint32_t tid;
+#ifdef USE_THREADS
+    std::atomic<uint32_t> ready; // Position of the event in the ring + 1, once written
+#else
+    uint32_t ready;
+#endif
+};
+
+// Room for several seconds of events, should the writer fall behind
+static const uint32_t RING_SIZE = 1 << 15;
+static event_t ring[RING_SIZE];
+
+// Events are claimed at head by the threads being traced, and written out from tail by the writer.
+// Positions count up indefinitely: The slot is the position modulo the ring size.
+#ifdef USE_THREADS
+static std::atomic<uint32_t> head(0);
+static std::atomic<uint32_t> tail(0);
+static std::atomic<uint32_t> dropped(0);
+static std::atomic<uint32_t> next_tid(0);
+#else
+static uint32_t head    = 0;
+static uint32_t tail    = 0;
+static uint32_t dropped = 0;
+static uint32_t next_tid = 0;
+#endif
+
+static RFILE* file       = NULL;
+static uint64_t origin   = 0;     // Time of start(). Event times are written relative to this.
+static bool first_event  = true;
+
+static const uint32_t MAX_THREADS = 16;
+static const char* thread_names[MAX_THREADS];
+
+#ifdef USE_THREADS
+static thread_local uint32_t tid = 0;
+
+static std::thread*            writer = NULL;
+static std::mutex              writer_lock;
+static std::condition_variable writer_cv;
+static bool                    writer_quit;
+#else
+static uint32_t tid = 0;
+#endif
+
+uint64_t trace::now()
+{
+    return timing::now();
+}
+
+static uint32_t thread_id()
+{
+    if (tid == 0)
+        tid = ++next_tid;
+    return tid;
+}
+
+void trace::name_thread(const char* name)
+{
+    const uint32_t id = thread_id();
+    if (id < MAX_THREADS)
+        thread_names[id] = name;
+}
+
+void trace::record(const char* name, uint64_t start)
+{
+    const uint64_t end = now();
+
+#ifdef USE_THREADS
+    uint32_t pos = head.load(std::memory_order_relaxed);
+    do
+    {
+        if (pos - tail.load(std::memory_order_acquire) >= RING_SIZE)
+        {
+            dropped++;
+            return;
+        }
+    }
+    while (!head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed));
+#else
+    if (head - tail >= RING_SIZE)
+    {
+        dropped++;
+        return;
+    }
+    const uint32_t pos = head++;
+#endif
+
+    event_t& e = ring[pos & (RING_SIZE - 1)];
+    e.name     = name;
+    e.start    = start;
+    e.duration = end - start;
+    e.tid      = thread_id();
+#ifdef USE_THREADS
+    e.ready.store(pos + 1, std::memory_order_release);
+#else
+    e.ready    = pos + 1;
+#endif
+}
+
+static void write_text(const std::string& text)
+{
+    if (file && !text.empty())
+        filestream_write(file, text.c_str(), text.size());
+}
+
+// Write out the events recorded so far. Only called by one thread at a time.
+static void drain()
+{
+    std::string out;
+    char line[160];
+
+#ifdef USE_THREADS
+    uint32_t pos = tail.load(std::memory_order_relaxed);
+    while (pos != head.load(std::memory_order_acquire))
+    {
+        const event_t& e = ring[pos & (RING_SIZE - 1)];
+
+        // Claimed, but still being written
+        if (e.ready.load(std::memory_order_acquire) != pos + 1)
+            break;
+#else
+    uint32_t pos = tail;
+    while (pos != head)
+    {
+        const event_t& e = ring[pos & (RING_SIZE - 1)];
+#endif
+        snprintf(line, sizeof(line), "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                 first_event ? "\n" : ",\n", e.name, e.tid, (e.start - origin) / 1e3, e.duration / 1e3);
+        out += line;
+        first_event = false;
+        pos++;
+
+#ifdef USE_THREADS
+        tail.store(pos, std::memory_order_release);
+#else
+        tail = pos;
+#endif
+    }
+
+    write_text(out);
+}
+
+#ifdef USE_THREADS
+static void writer_loop()
+{
+    std::unique_lock<std::mutex> guard(writer_lock);
+
+    while (!writer_quit)
+    {
+        writer_cv.wait_for(guard, std::chrono::milliseconds(100));
+
+        guard.unlock();
+        drain();
+        guard.lock();
+    }
+}
+#endif
+
+bool trace::start(const char* filename)
+{
+    stop();
+
+    file = filestream_open(filename, RETRO_VFS_FILE_ACCESS_WRITE, RETRO_VFS_FILE_ACCESS_HINT_NONE);
+    if (file == NULL)
+        return false;
+
+    head        = 0;
+    tail        = 0;
+    dropped     = 0;
+    first_event = true;
+    origin      = now();
+    for (uint32_t i = 0; i < RING_SIZE; i++)
+        ring[i].ready = 0;
+
+    write_text("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    name_thread("Main");
+
+#ifdef USE_THREADS
+    writer_quit = false;
+    writer      = new std::thread(writer_loop);
+#endif
+
+    enabled = true;
+    return true;
+}
+
+void trace::stop()
+{
+    if (file == NULL)
+        return;
+
+    enabled = false;
+
+#ifdef USE_THREADS
+    {
+        std::lock_guard<std::mutex> guard(writer_lock);
+        writer_quit = true;
+        writer_cv.notify_all();
+    }
+    writer->join();
+    delete writer;
+    writer = NULL;
+#endif
+
+    // Events the writer had not reached
+    drain();
+
+    std::string out;
+    char line[160];
+    for (uint32_t i = 1; i < MAX_THREADS; i++)
+    {
+        if (thread_names[i] == NULL)
+            continue;
+        snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                 first_event ? "\n" : ",\n", i, thread_names[i]);
+        out += line;
+        first_event = false;
+    }
+    snprintf(line, sizeof(line), "\n],\"otherData\":{\"dropped_events\":%u}}\n", (uint32_t) dropped);
+    out += line;
+    write_text(out);
+
+    filestream_close(file);
+    file = NULL;
+}
+
+void trace::poll()
+{
+#ifndef USE_THREADS
+    if (enabled)
+        drain();
+#endif
+}
@@ -0,0 +1,71 @@
+/***************************************************************************
+    Frame Tracing.
+
+    Records the start and duration of each phase of a frame (controls,
+    game logic, sound, each layer of the video hardware) to a trace file,
+    in the Chrome trace event format. Open the file in chrome://tracing or
+    ui.perfetto.dev to see where the time went on any given frame, and
+    whether a slow frame was spent in the core or in the frontend (the
+    gap between one retro_run and the next).
+
+    Events are written to a lock-free ring in memory by any thread, and
+    written out to the file by a thread of their own. If the writer falls
+    behind, new events are dropped rather than stalling the game.
+
+    When capture is off, each traced phase costs a test of a flag.
+
+    Copyright Chris White.
+    See license.txt for more details.
+***************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+
+namespace trace
+{
+    extern bool enabled;
+
+    uint64_t now();
+
+    // Begin writing events to the given file
+    bool start(const char* filename);
+
+    // Write any outstanding events and close the file
+    void stop();
+
+    // Without threads, the events are written from here instead. Call once per frame.
+    void poll();
+
+    // Name the calling thread in the trace
+    void name_thread(const char* name);
+
+    // A phase that began at start and has just ended. Name must be a string literal.
+    void record(const char* name, uint64_t start);
+
+    // Records the time from construction to destruction as a phase
+    class Scope
+    {
+    public:
+        Scope(const char* name)
+        {
+            if (enabled)
+            {
+                this->name = name;
+                start      = now();
+            }
+            else
+                this->name = 0;
+        }
+
+        ~Scope()
+        {
+            if (name)
+                record(name, start);
+        }
+
+    private:
+        const char* name;
+        uint64_t start;
+    };
+}
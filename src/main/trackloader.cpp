@@ -18,6 +18,7 @@
 #include "roms.hpp"
 #include "engine/outrun.hpp"
 #include "engine/oaddresses.hpp"
+#include "savestate.hpp"
 
 extern retro_log_printf_t                 log_cb;
 
@@ -51,7 +52,7 @@ static uint8_t STAGE_MAPPING_JAP[] =
     0x32, 0x23, 0x38, 0x22, 0x26, 0x00, 0x00, 0x00,  // Stage 5
 };
 
-TrackLoader trackloader;
+ENGINE_GLOBAL TrackLoader trackloader;
 
 TrackLoader::TrackLoader()
 {
@@ -69,6 +70,8 @@ TrackLoader::~TrackLoader()
     if (layout != NULL)
         delete layout;
 
+    free_compiled();
+
     delete[] levels_end;
     delete[] levels;
     delete level_split;
@@ -76,6 +79,8 @@ TrackLoader::~TrackLoader()
 
 void TrackLoader::init(bool jap)
 {
+    free_compiled();
+
     if (mode == MODE_ORIGINAL)
         init_original_tracks(jap);
     else
@@ -127,7 +132,7 @@ void TrackLoader::init_original_tracks(bool jap)
 
         // CPU 1 Data
         const uint32_t PATH_ADR = roms.rom1p->read32(ROAD_DATA_LOOKUP + STAGE_OFFSET);
-        levels[i].path = &roms.rom1p->rom[PATH_ADR];        
+        levels[i].path = compile(roms.rom1p, PATH_ADR);
     }
 
     // --------------------------------------------------------------------------------------------
@@ -136,13 +141,13 @@ void TrackLoader::init_original_tracks(bool jap)
 
     // Split stages don't contain palette information
     setup_section(level_split, roms.rom0p, outrun.adr.road_seg_split);
-    level_split->path         = &roms.rom1p->rom[ROAD_DATA_SPLIT];
+    level_split->path         = compile(roms.rom1p, ROAD_DATA_SPLIT);
 
     for (int i = 0; i < 5; i++)
     {
         const uint32_t STAGE_ADR = roms.rom0p->read32(outrun.adr.road_seg_end + (i << 2));
         setup_section(&levels_end[i], roms.rom0p, STAGE_ADR);
-        levels_end[i].path  = &roms.rom1p->rom[ROAD_DATA_BONUS];
+        levels_end[i].path  = compile(roms.rom1p, ROAD_DATA_BONUS);
     }
 }
 
@@ -192,7 +197,7 @@ void TrackLoader::init_layout_tracks(bool jap)
 
         // CPU 1 Data
         const uint32_t PATH_ADR = layout->read32(LayOut::PATH);
-        levels[i].path = &layout->rom[ PATH_ADR + ((ROAD_END_CPU1 * sizeof(uint32_t)) * i) ];
+        levels[i].path = compile(layout, PATH_ADR + ((ROAD_END_CPU1 * sizeof(uint32_t)) * i));
     }
 
     // --------------------------------------------------------------------------------------------
@@ -201,10 +206,10 @@ void TrackLoader::init_layout_tracks(bool jap)
 
     // Split stages don't contain palette information
     setup_section(level_split, layout, layout->read32(LayOut::SPLIT_LEVEL));
-    level_split->path = &layout->rom[ layout->read32(LayOut::SPLIT_PATH) ];
+    level_split->path = compile(layout, layout->read32(LayOut::SPLIT_PATH));
 
     // End sections don't contain palette information. Shared path.
-    uint8_t* end_path = &layout->rom[ layout->read32(LayOut::END_PATH) ];
+    const uint16_t* end_path = compile(layout, layout->read32(LayOut::END_PATH));
     for (int i = 0; i < 5; i++)
     {
         const uint32_t STAGE_ADR = layout->read32(LayOut::END_LEVELS + (i * sizeof(uint32_t)));
@@ -241,17 +246,19 @@ void TrackLoader::setup_level(Level* l, RomLoader* data, const int STAGE_ADR)
     adr = data->read32(STAGE_ADR + 20);
     l->pal_gnd = data->read16(adr);
 
+    compile_palettes(l);
+
     // Curve Data
     curve_offset = data->read32(STAGE_ADR + 24);
-    l->curve = &data->rom[curve_offset];
+    l->curve = compile(data, curve_offset);
 
     // Width / Height Lookup
     wh_offset = data->read32(STAGE_ADR + 28);
-    l->width_height = &data->rom[wh_offset];
+    l->width_height = compile(data, wh_offset);
 
     // Sprite Information
     scenery_offset = data->read32(STAGE_ADR + 32);
-    l->scenery = &data->rom[scenery_offset];
+    l->scenery = compile(data, scenery_offset);
 }
 
 // Setup a special section of track (end section or level split)
@@ -260,15 +267,57 @@ void TrackLoader::setup_section(Level* l, RomLoader* data, const int STAGE_ADR)
 {
     // Curve Data
     curve_offset = data->read32(STAGE_ADR + 0);
-    l->curve = &data->rom[curve_offset];
+    l->curve = compile(data, curve_offset);
 
     // Width / Height Lookup
     wh_offset = data->read32(STAGE_ADR + 4);
-    l->width_height = &data->rom[wh_offset];
+    l->width_height = compile(data, wh_offset);
 
     // Sprite Information
     scenery_offset = data->read32(STAGE_ADR + 8);
-    l->scenery = &data->rom[scenery_offset];
+    l->scenery = compile(data, scenery_offset);
+}
+
+// Resolve track data at a byte address to native endian words.
+//
+// The data runs to the end of its source, as the formats are read until a marker or the
+// end of the level. Word aligned data is a view of the source's native copy. Unaligned
+// data (only possible in a LayOut file) is copied.
+const uint16_t* TrackLoader::compile(RomLoader* data, const uint32_t adr)
+{
+    if (data->rom16 == NULL)
+        data->build_native();
+
+    if ((adr & 1) == 0)
+        return &data->rom16[adr >> 1];
+
+    const uint32_t words = (data->length - adr) >> 1;
+    uint16_t* copy = new uint16_t[words + 1];
+    for (uint32_t i = 0; i < words; i++)
+        copy[i] = data->read16(adr + (i << 1));
+    copy[words] = 0;
+
+    compiled.push_back(copy);
+    return copy;
+}
+
+void TrackLoader::free_compiled()
+{
+    for (size_t i = 0; i < compiled.size(); i++)
+        delete[] compiled[i];
+    compiled.clear();
+}
+
+// Copy out the level's sky and ground palettes
+void TrackLoader::compile_palettes(Level* l)
+{
+    uint32_t src = read_pal_sky_table(l->pal_sky);
+    for (int i = 0; i < 0x20; i++)
+        l->sky[i] = read32(pal_sky_data, &src);
+
+    src = read_pal_gnd_table(l->pal_gnd);
+    for (int i = 0; i < 0x10; i++)
+        l->ground[i] = read16(pal_gnd_data, &src);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -325,52 +374,66 @@ void TrackLoader::init_path_end()
     current_path = levels_end[0].path; // Path is shared for end sections
 }
 
-// ------------------------------------------------------------------------------------------------
-//                                        HELPER FUNCTIONS TO READ DATA
-// ------------------------------------------------------------------------------------------------
-
-int16_t TrackLoader::readPath(uint32_t addr)
+Level* TrackLoader::get_level(uint32_t id)
 {
-    return (current_path[addr] << 8) | current_path[addr+1];
+    return &levels[stage_offset_to_level(id)];
 }
 
-int16_t TrackLoader::readPath(uint32_t* addr)
-{
-    int16_t value = (current_path[*addr] << 8) | (current_path[*addr+1]);
-    *addr += 2;
-    return value;
-}
+// ------------------------------------------------------------------------------------------------
+//                                        SAVE STATE SUPPORT
+// ------------------------------------------------------------------------------------------------
 
-int16_t TrackLoader::read_width_height(uint32_t* addr)
+// Levels are numbered in a save state as follows:
+// 0 - 14: Normal Stages, 15: Split Section, 16 - 20: End Sections
+Level* TrackLoader::level_from_index(uint8_t index)
 {
-    int16_t value = (current_level->width_height[*addr + wh_offset] << 8) | (current_level->width_height[*addr+1 + wh_offset]);
-    *addr += 2;
-    return value;
+    if (index < STAGES)
+        return &levels[index];
+    else if (index == STAGES)
+        return level_split;
+    else if (index <= STAGES + 5)
+        return &levels_end[index - STAGES - 1];
+    else
+        return &levels[0];
 }
 
-int16_t TrackLoader::read_curve(uint32_t addr)
+uint8_t TrackLoader::level_to_index(Level* l)
 {
-    return (current_level->curve[addr + curve_offset] << 8) | current_level->curve[addr+1 + curve_offset];
+    for (uint8_t i = 0; i <= STAGES + 5; i++)
+    {
+        if (level_from_index(i) == l)
+            return i;
+    }
+    return 0;
 }
 
-uint16_t TrackLoader::read_scenery_pos()
+uint8_t TrackLoader::path_to_index(const uint16_t* path)
 {
-    return (current_level->scenery[scenery_offset] << 8) | current_level->scenery[scenery_offset + 1];
+    for (uint8_t i = 0; i <= STAGES + 5; i++)
+    {
+        if (level_from_index(i)->path == path)
+            return i;
+    }
+    return 0;
 }
 
-uint8_t TrackLoader::read_total_sprites()
+// Track data is fixed once loaded, so only the current level and read positions are saved
+void TrackLoader::sync_state(StateBuf& state)
 {
-    return current_level->scenery[scenery_offset + 2];
-}
+    uint8_t level = level_to_index(current_level);
+    uint8_t path  = path_to_index(current_path);
 
-uint8_t TrackLoader::read_sprite_pattern_index()
-{
-    return current_level->scenery[scenery_offset + 3];
-}
+    state.sync(level);
+    state.sync(path);
+    state.sync(curve_offset);
+    state.sync(wh_offset);
+    state.sync(scenery_offset);
 
-Level* TrackLoader::get_level(uint32_t id)
-{
-    return &levels[stage_offset_to_level(id)];
+    if (state.loading())
+    {
+        current_level = level_from_index(level);
+        current_path  = level_from_index(path)->path;
+    }
 }
 
 uint32_t TrackLoader::read_pal_sky_table(uint16_t entry)
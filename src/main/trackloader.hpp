@@ -7,6 +7,11 @@
     - Handles levels (path, width, height, scenery)
     - Handles additional level sections (road split, end section)
     - Handles road/level related palettes
+
+    Levels are compiled when the tracks are set up: Each level's path,
+    curve, width/height and scenery data is resolved to an array of native
+    endian words, and its palettes are copied out. The engine then reads
+    tracks with indexed loads.
     
     Copyright Chris White.
     See license.txt for more details.
@@ -14,6 +19,7 @@
 
 #pragma once
 
+#include <vector>
 #include "globals.hpp"
 
 // Road Generator Palette Representation
@@ -25,17 +31,20 @@ struct RoadPalette
     uint32_t road;            // Main Road Colour
 };
 
-// OutRun Level Representation
+// OutRun Level Representation. Track data is in native endian words.
 struct Level
 {
-    uint8_t* path;            // CPU 1 Path Data
-    uint8_t* curve;           // Track Curve Information (Derived From Path)
-    uint8_t* width_height;    // Track Width & Height Lookups
-    uint8_t* scenery;         // Track Scenery Lookups
+    const uint16_t* path;         // CPU 1 Path Data
+    const uint16_t* curve;        // Track Curve Information (Derived From Path)
+    const uint16_t* width_height; // Track Width & Height Lookups
+    const uint16_t* scenery;      // Track Scenery Lookups
 
     uint16_t pal_sky;         // Index into Sky Palettes
     uint16_t pal_gnd;         // Index into Ground Palettes
 
+    uint32_t sky[0x20];       // Sky Palette Entries
+    uint16_t ground[0x10];    // Ground Palette Entries
+
     RoadPalette palr1;        // Road 1 Generator Palette
     RoadPalette palr2;        // Road 2 Generator Palette
 };
@@ -59,6 +68,7 @@ struct LayOut
 };
 
 class RomLoader;
+class StateBuf;
 
 class TrackLoader
 {
@@ -109,17 +119,51 @@ public:
     uint32_t read_heightmap_table(uint16_t entry);
     uint32_t read_scenerymap_table(uint16_t entry);
 
-    int16_t readPath(uint32_t addr);
-    int16_t readPath(uint32_t* addr);
-    int16_t read_width_height(uint32_t* addr);
-    int16_t read_curve(uint32_t addr);
-    uint16_t read_scenery_pos();
-    uint8_t read_total_sprites();
-    uint8_t read_sprite_pattern_index();
+    // Track data is addressed in bytes, as in the original format, and read a word at a time
+    inline int16_t readPath(uint32_t addr)
+    {
+        return current_path[addr >> 1];
+    }
+
+    inline int16_t readPath(uint32_t* addr)
+    {
+        int16_t value = current_path[*addr >> 1];
+        *addr += 2;
+        return value;
+    }
+
+    inline int16_t read_width_height(uint32_t* addr)
+    {
+        int16_t value = current_level->width_height[(*addr + wh_offset) >> 1];
+        *addr += 2;
+        return value;
+    }
+
+    inline int16_t read_curve(uint32_t addr)
+    {
+        return current_level->curve[(addr + curve_offset) >> 1];
+    }
+
+    inline uint16_t read_scenery_pos()
+    {
+        return current_level->scenery[scenery_offset >> 1];
+    }
+
+    inline uint8_t read_total_sprites()
+    {
+        return current_level->scenery[(scenery_offset >> 1) + 1] >> 8;
+    }
+
+    inline uint8_t read_sprite_pattern_index()
+    {
+        return current_level->scenery[(scenery_offset >> 1) + 1] & 0xFF;
+    }
 
     int8_t stage_offset_to_level(uint32_t);
     Level* get_level(uint32_t);
 
+    void sync_state(StateBuf& state);
+
     inline int32_t read32(uint8_t* data, uint32_t* addr)
     {    
         int32_t value = (data[*addr] << 24) | (data[*addr+1] << 16) | (data[*addr+2] << 8) | (data[*addr+3]);
@@ -164,10 +208,21 @@ private:
     Level* level_split;    // Split Section
     Level* levels_end;     // End Section
 
-    uint8_t* current_path; // CPU 1 Road Path
+    const uint16_t* current_path; // CPU 1 Road Path
+
+    // Track data compiled from unaligned source data, freed when the tracks are next set up
+    std::vector<uint16_t*> compiled;
     
+    Level* level_from_index(uint8_t);
+    uint8_t level_to_index(Level*);
+    uint8_t path_to_index(const uint16_t*);
+
+    void free_compiled();
+    const uint16_t* compile(RomLoader* data, const uint32_t adr);
+    void compile_palettes(Level* l);
+
     void setup_level(Level* l, RomLoader* data, const int STAGE_ADR);
     void setup_section(Level* l, RomLoader* data, const int STAGE_ADR);
 };
 
-extern TrackLoader trackloader;
+extern ENGINE_GLOBAL TrackLoader trackloader;
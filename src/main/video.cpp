@@ -17,6 +17,10 @@
 #endif
 #include "globals.hpp"
 #include "frontend/config.hpp"
+#include "savestate.hpp"
+#include "timing.hpp"
+#include "trace.hpp"
+#include "perfhud.hpp"
 
 #ifdef WITH_OPENGL
 
@@ -45,7 +49,7 @@ extern retro_video_refresh_t       video_cb;
 #define CURRENT_RGB() (r << Rshift) | (g << Gshift) | (b << Bshift);
 #endif //SDL2
 
-Video video;
+ENGINE_GLOBAL Video video;
 
 Video::Video(void)
 {
@@ -66,9 +70,12 @@ Video::Video(void)
     #endif
 #endif
 
-    pixels       = NULL;
-    sprite_layer = new hwsprites();
-    tile_layer   = new hwtiles();
+    pixels        = NULL;
+    sprite_layer  = new hwsprites();
+    tile_layer    = new hwtiles();
+    frame_saved   = false;
+    display_phase = 0;
+    display_alpha = BLEND_ONE;
 }
 
 Video::~Video(void)
@@ -168,8 +175,38 @@ int Video::set_video_mode(video_settings_t* settings)
     return 1;
 }
 
-void Video::draw_frame()
+// Interpolated frames: The display runs at refresh_rate, faster than the engine's engine_rate.
+// Returns true when an engine frame is due before the next display frame. Call once per display frame.
+bool Video::step_display(int engine_rate, int refresh_rate)
 {
+    // Rates changed
+    if (display_phase >= (uint32_t) refresh_rate)
+        display_phase = 0;
+
+    display_phase += engine_rate;
+    const bool due = display_phase >= (uint32_t) refresh_rate;
+    if (due)
+        display_phase -= refresh_rate;
+
+    display_alpha = (display_phase * BLEND_ONE) / refresh_rate;
+    return due;
+}
+
+// Keep the frame on display, to blend from. Call before each engine frame.
+void Video::save_frame()
+{
+    tile_layer->save_frame();
+    sprite_layer->save_frame();
+    hwroad.save_frame();
+    frame_saved = true;
+}
+
+// Draw the frame. With alpha below BLEND_ONE, the scroll values, sprite positions and road 
+// are blended with those of the frame kept by save_frame(), by that weight.
+void Video::draw_frame(uint16_t alpha)
+{
+    trace::Scope phase("video.draw_frame");
+
 #ifndef __LIBRETRO__
     // Renderer Specific Frame Setup
     if (!renderer->start_frame())
@@ -187,24 +224,52 @@ void Video::draw_frame()
     }
     else
     {
+        if (!frame_saved)
+            alpha = BLEND_ONE;
+
         // OutRun Hardware Video Emulation
-        tile_layer->update_tile_values();
-
-        (hwroad.*hwroad.render_background)(pixels);
-        tile_layer->render_tile_layer(pixels, 1, 0);      // background layer
-        tile_layer->render_tile_layer(pixels, 0, 0);      // foreground layer
-        (hwroad.*hwroad.render_foreground)(pixels);
-        sprite_layer->render(8);
-        tile_layer->render_text_layer(pixels, 1);
+        {
+            timing::Scope t(timing::TILES);
+            tile_layer->update_tile_values();
+            tile_layer->blend_frame(alpha);
+        }
+        sprite_layer->blend_frame(alpha);
+        hwroad.blend_frame(alpha);
+        {
+            timing::Scope t(timing::ROAD);
+            (hwroad.*hwroad.render_background)(pixels);
+        }
+        {
+            timing::Scope t(timing::TILES);
+            tile_layer->render_tile_layer(pixels, 1, 0);      // background layer
+            tile_layer->render_tile_layer(pixels, 0, 0);      // foreground layer
+        }
+        {
+            timing::Scope t(timing::ROAD);
+            (hwroad.*hwroad.render_foreground)(pixels);
+        }
+        {
+            timing::Scope t(timing::SPRITES);
+            sprite_layer->render(8);
+        }
+        {
+            timing::Scope t(timing::TILES);
+            tile_layer->render_text_layer(pixels, 1);
+        }
      }
 
 #ifdef __LIBRETRO__
     {
+       timing::Scope t(timing::PALETTE);
        uint16_t *spix    = pixels;
 
        for (int i = 0; i < (config.s16_width * config.s16_height); i++)
           spix[i] = rgb[spix[i] % (S16_PALETTE_ENTRIES * 3)];
 
+       // Drawn over the finished picture
+       if (perfhud::enabled)
+          perfhud::draw(pixels, config.s16_width, config.s16_height);
+
        video_cb(pixels, config.s16_width, config.s16_height,
              config.s16_width << 1);
     }
@@ -214,6 +279,43 @@ void Video::draw_frame()
 #endif
 }
 
+// Skip rendering this frame. The frontend repeats the previous frame instead.
+void Video::skip_frame()
+{
+#ifdef __LIBRETRO__
+    video_cb(NULL, config.s16_width, config.s16_height, config.s16_width << 1);
+#endif
+}
+
+// Save or restore the contents of video RAM: Palette, tiles, text, sprites and road.
+// Decoded graphics and converted colours are derived from these, so aren't saved.
+// The previous frame and display timing kept for interpolated frames are included,
+// so a frame run again after loading a state (run-ahead, netplay) is drawn the same.
+void Video::sync_state(StateBuf& state)
+{
+    state.sync(palette);
+    tile_layer->sync_state(state);
+    sprite_layer->sync_state(state);
+    hwroad.sync_state(state);
+    state.sync(frame_saved);
+    state.sync(display_phase);
+
+    if (state.loading())
+    {
+        for (uint32_t i = 0; i < S16_PALETTE_ENTRIES; i++)
+            refresh_palette(i << 1);
+    }
+}
+
+void Video::hash_state(StateHash& hash)
+{
+    hash.add_bytes(palette, sizeof(palette));
+    hash.add_bytes(tile_layer->text_ram, sizeof(tile_layer->text_ram));
+    hash.add_bytes(tile_layer->tile_ram, sizeof(tile_layer->tile_ram));
+    sprite_layer->hash_state(hash);
+    hwroad.hash_state(hash);
+}
+
 // ---------------------------------------------------------------------------
 // Text Handling Code
 // ---------------------------------------------------------------------------
@@ -22,6 +22,8 @@ class hwsprites;
 class RenderBase;
 
 struct video_settings_t;
+class StateBuf;
+class StateHash;
 
 class Video
 {
@@ -32,13 +34,21 @@ public:
 
     bool enabled;
 
+    // Interpolated frames: Weight of the latest engine frame in the display frame
+    uint16_t display_alpha;
+
 	Video();
     ~Video();
     
 	int init(Roms* roms, video_settings_t* settings);
     void disable();
     int set_video_mode(video_settings_t* settings);
-    void draw_frame();
+    bool step_display(int engine_rate, int refresh_rate);
+    void save_frame();
+    void draw_frame(uint16_t alpha = BLEND_ONE);
+    void skip_frame();
+    void sync_state(StateBuf& state);
+    void hash_state(StateHash& hash);
 
     void clear_text_ram();
     void write_text8(uint32_t, const uint8_t);
@@ -77,7 +87,13 @@ private:
 #endif
     
 	uint8_t palette[S16_PALETTE_ENTRIES * 2]; // 2 Bytes Per Palette Entry
+
+    // Interpolated frames: A frame has been kept to blend from, and engine frames elapsed 
+    // since the latest, in units of 1/refresh rate
+    bool frame_saved;
+    uint32_t display_phase;
+
     void refresh_palette(uint32_t);
 };
 
-extern Video video;
+extern ENGINE_GLOBAL Video video;